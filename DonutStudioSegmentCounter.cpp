@@ -0,0 +1,258 @@
+/*
+  DonutStudioSegmentCounter.h - Counters and clocks that only rewrite the digits that changed.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "Arduino.h"
+#include "DonutStudioSegmentCounter.h"
+
+/*
+  --- CONSTRUCTOR ---
+*/
+
+SegmentCounter::SegmentCounter(SegmentControllerBase& display, bool showLeadZeros)
+{
+  _display = &display;
+  _showLeadZeros = showLeadZeros;
+  _length = display.getDisplayLength();
+  for (int i = 0; i < _length; i++)
+    _decimals[i] = 0;
+  show();
+}
+
+SegmentClock::SegmentClock(SegmentControllerBase& display, byte layout, bool showLeadZero)
+{
+  _display = &display;
+  _layout = layout;
+  _showLeadZero = showLeadZero;
+  for (int i = 0; i < 4; i++)
+    _decimals[i] = 0;
+  show();
+}
+
+
+/*
+  --- COUNTER ---
+*/
+
+void SegmentCounter::set(unsigned long value)
+{
+  for (int i = 0; i < _length; i++)
+  {
+    setDecimal(i, value % 10);
+    value /= 10;
+  }
+  updateLength();
+}
+unsigned long SegmentCounter::get()
+{
+  unsigned long value = 0;
+  for (int i = _length - 1; i >= 0; i--)
+    value = value * 10 + _decimals[i];
+  return value;
+}
+void SegmentCounter::increment()
+{
+  add(1);
+}
+void SegmentCounter::decrement()
+{
+  add(-1);
+}
+void SegmentCounter::add(long delta)
+{
+  bool negative = delta < 0;
+  unsigned long amount = negative ? 0UL - (unsigned long)delta : (unsigned long)delta;
+
+  // digit by digit from the right, stops as soon as nothing is left to carry (a step of one mostly touches one digit)
+  byte carry = 0;
+  for (int i = 0; i < _length && (amount != 0 || carry != 0); i++)
+  {
+    int decimal = amount % 10 + carry;
+    amount /= 10;
+    decimal = negative ? _decimals[i] - decimal : _decimals[i] + decimal;
+
+    carry = 0;
+    if (decimal < 0)
+    {
+      decimal += 10;
+      carry = 1;
+    }
+    else if (decimal > 9)
+    {
+      decimal -= 10;
+      carry = 1;
+    }
+    setDecimal(i, decimal);
+  }
+  updateLength();
+}
+void SegmentCounter::reset()
+{
+  set(0);
+}
+void SegmentCounter::show()
+{
+  for (int i = 0; i < _length; i++)
+    showDigit(i);
+}
+
+void SegmentCounter::setDecimal(byte index, byte decimal)
+{
+  if (_decimals[index] == decimal)
+    return;
+  _decimals[index] = decimal;
+  showDigit(index);
+}
+void SegmentCounter::showDigit(byte index)
+{
+  // lead zeros stay blank, the right-most digit always shows its decimal
+  if (_showLeadZeros || index < _usedLength)
+    _display->setDigit(_length - 1 - index, _display->getNumber(_decimals[index]));
+  else
+    _display->setDigit(_length - 1 - index, _display->getNumber(-1));
+}
+void SegmentCounter::updateLength()
+{
+  byte usedLength = 1;
+  for (int i = _length - 1; i > 0; i--)
+  {
+    if (_decimals[i] != 0)
+    {
+      usedLength = i + 1;
+      break;
+    }
+  }
+  if (usedLength == _usedLength)
+    return;
+
+  // the digits between the old and the new length changed from/to lead zeros
+  byte from = usedLength < _usedLength ? usedLength : _usedLength;
+  byte to = usedLength < _usedLength ? _usedLength : usedLength;
+  _usedLength = usedLength;
+  if (_showLeadZeros)
+    return;
+  for (int i = from; i < to; i++)
+    showDigit(i);
+}
+
+
+/*
+  --- CLOCK ---
+*/
+
+void SegmentClock::setTime(byte hours, byte minutes, byte seconds)
+{
+  byte left = _layout == CLOCK_HOURS_MINUTES ? hours % 24 : minutes % 60;
+  byte right = _layout == CLOCK_HOURS_MINUTES ? minutes % 60 : seconds % 60;
+  _hiddenTime = _layout == CLOCK_HOURS_MINUTES ? seconds % 60 : hours % 24;
+
+  setDecimal(0, left / 10);
+  setDecimal(1, left % 10);
+  setDecimal(2, right / 10);
+  setDecimal(3, right % 10);
+}
+byte SegmentClock::getHours()
+{
+  if (_layout == CLOCK_HOURS_MINUTES)
+    return _decimals[0] * 10 + _decimals[1];
+  return _hiddenTime;
+}
+byte SegmentClock::getMinutes()
+{
+  if (_layout == CLOCK_HOURS_MINUTES)
+    return _decimals[2] * 10 + _decimals[3];
+  return _decimals[0] * 10 + _decimals[1];
+}
+byte SegmentClock::getSeconds()
+{
+  if (_layout == CLOCK_HOURS_MINUTES)
+    return _hiddenTime;
+  return _decimals[2] * 10 + _decimals[3];
+}
+void SegmentClock::tickSecond()
+{
+  if (_colonBlinking)
+    setColon(!_colon);
+
+  if (_layout == CLOCK_MINUTES_SECONDS)
+    carry(3);
+  else if (++_hiddenTime >= 60)
+  {
+    _hiddenTime = 0;
+    carry(3);
+  }
+}
+void SegmentClock::tickMinute()
+{
+  carry(_layout == CLOCK_HOURS_MINUTES ? 3 : 1);
+}
+
+void SegmentClock::setColon(bool value)
+{
+  _colon = value;
+  _display->setOverlaySegment(1, 7, value);
+}
+bool SegmentClock::getColon()
+{
+  return _colon;
+}
+void SegmentClock::setColonBlinking(bool value)
+{
+  _colonBlinking = value;
+}
+bool SegmentClock::getColonBlinking()
+{
+  return _colonBlinking;
+}
+void SegmentClock::show()
+{
+  for (int i = 0; i < 4; i++)
+    showDigit(i);
+  setColon(_colon);
+}
+
+void SegmentClock::carry(byte position)
+{
+  // add one to a digit, every digit that reaches its radix carries to the one on its left
+  for (int i = position; i >= 0; i--)
+  {
+    byte decimal = _decimals[i] + 1;
+    if (decimal < getRadix(i))
+    {
+      setDecimal(i, decimal);
+      return;
+    }
+    setDecimal(i, 0);
+  }
+
+  // past the left-most digit: the next hour of a minutes:seconds clock, a new day otherwise
+  if (_layout == CLOCK_MINUTES_SECONDS)
+    _hiddenTime = _hiddenTime + 1 >= 24 ? 0 : _hiddenTime + 1;
+}
+byte SegmentClock::getRadix(byte position)
+{
+  // HH:MM = 0-2 0-9 (0-3 after a 2) : 0-5 0-9, MM:SS = 0-5 0-9 : 0-5 0-9
+  if (position == 0)
+    return _layout == CLOCK_HOURS_MINUTES ? 3 : 6;
+  if (position == 1)
+    return _layout == CLOCK_HOURS_MINUTES && _decimals[0] == 2 ? 4 : 10;
+  if (position == 2)
+    return 6;
+  return 10;
+}
+void SegmentClock::setDecimal(byte position, byte decimal)
+{
+  if (_decimals[position] == decimal)
+    return;
+  _decimals[position] = decimal;
+  showDigit(position);
+}
+void SegmentClock::showDigit(byte position)
+{
+  if (position == 0 && !_showLeadZero && _decimals[0] == 0)
+    _display->setDigit(0, _display->getNumber(-1));
+  else
+    _display->setDigit(position, _display->getNumber(_decimals[position]));
+}
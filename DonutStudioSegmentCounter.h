@@ -0,0 +1,110 @@
+/*
+  DonutStudioSegmentCounter.h - Counters and clocks that only rewrite the digits that changed.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+/*
+--- odometer ---
+
+  every digit keeps its decimal, a step adds to the right-most digit and carries to the left:
+
+    1 2 9 9  ->  1 3 0 0   (three digits written)
+    1 2 3 4  ->  1 2 3 5   (one digit written)
+
+  clock layouts (first four digits, the dp of the second digit is the colon):
+
+    CLOCK_HOURS_MINUTES      H H : M M   (00:00 - 23:59, the seconds are counted but not shown)
+    CLOCK_MINUTES_SECONDS    M M : S S   (00:00 - 59:59, the hours are counted but not shown)
+*/
+
+
+
+#ifndef DonutStudioSegmentCounter_h
+#define DonutStudioSegmentCounter_h
+
+
+#define CLOCK_HOURS_MINUTES 0
+#define CLOCK_MINUTES_SECONDS 1
+
+
+#include "Arduino.h"
+#include "DonutStudioSevenSegment.h"
+
+// decimal counter on all digits of a display (aligned to the right), wraps around like an odometer
+class SegmentCounter
+{
+  public:
+    SegmentCounter(SegmentControllerBase& display, bool showLeadZeros = false);
+
+    // set the value (the digits that don't fit are left out)
+    void set(unsigned long value);
+    // get the value
+    unsigned long get();
+    // add one
+    void increment();
+    // subtract one (0 wraps around to 99...9)
+    void decrement();
+    // add a positive or negative amount
+    void add(long delta);
+    // start over at 0
+    void reset();
+    // write all digits again (e.g. after the display showed something else)
+    void show();
+
+  private:
+    void setDecimal(byte index, byte decimal);
+    void showDigit(byte index);
+    void updateLength();
+
+    SegmentControllerBase* _display;
+    bool _showLeadZeros;
+    byte _length;
+    // decimal of every digit (from the right-most digit) and the digits without lead zeros (at least one)
+    byte _decimals[MAXDIGITS];
+    byte _usedLength = 1;
+};
+
+// clock on the first four digits of a display, ticks carry from digit to digit
+class SegmentClock
+{
+  public:
+    SegmentClock(SegmentControllerBase& display, byte layout = CLOCK_HOURS_MINUTES, bool showLeadZero = true);
+
+    // set the time
+    void setTime(byte hours, byte minutes, byte seconds = 0);
+    byte getHours();
+    byte getMinutes();
+    byte getSeconds();
+    // one second later, the colon toggles if it blinks
+    void tickSecond();
+    // one minute later
+    void tickMinute();
+
+    // show/hide the colon
+    void setColon(bool value);
+    // check if the colon is shown
+    bool getColon();
+    // toggle the colon on every second
+    void setColonBlinking(bool value);
+    // check if the colon blinks
+    bool getColonBlinking();
+    // write all digits and the colon again (e.g. after the display showed something else)
+    void show();
+
+  private:
+    void carry(byte position);
+    byte getRadix(byte position);
+    void setDecimal(byte position, byte decimal);
+    void showDigit(byte position);
+
+    SegmentControllerBase* _display;
+    byte _layout;
+    bool _showLeadZero;
+    // decimal of every digit (from the left-most digit), the part of the time that isn't shown
+    byte _decimals[4];
+    byte _hiddenTime = 0;
+    bool _colon = true;
+    bool _colonBlinking = false;
+};
+#endif
@@ -0,0 +1,424 @@
+/*
+  DonutStudioSegmentDrivers.h - Output drivers for the seven-segment-display controller.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "Arduino.h"
+#include "DonutStudioSegmentDrivers.h"
+
+/*
+  --- GPIO ---
+*/
+
+SegmentGpioDriver::SegmentGpioDriver()
+{
+}
+SegmentGpioDriver::SegmentGpioDriver(bool commonAnode, bool hasDP, int segmentPins[8])
+{
+  _commonPinType = commonAnode ? 1 : 0;
+  _hasDP = hasDP;
+  for (int i = 0; i < 8; i++)
+    _segmentPins[i] = segmentPins[i];
+}
+
+void SegmentGpioDriver::begin(SegmentDigit* digits, byte displayLength)
+{
+  _digitStates = digits;
+  _displayLength = displayLength;
+
+  // set the segment pins (off: low for common cathode, high for common anode)
+  for (int i = 0; i < 8; i++)
+  {
+    pinMode(_segmentPins[i], OUTPUT);
+    digitalWrite(_segmentPins[i], _commonPinType);
+  }
+
+  // set the digit pins
+  for (int i = 0; i < _displayLength; i++)
+  {
+    pinMode(_digitStates[i].pin, OUTPUT);
+    digitalWrite(_digitStates[i].pin, 1 - _commonPinType);
+  }
+
+  resolvePorts();
+  translate(0, _blankState);
+  _segmentState = _blankState;
+  _segmentsKnown = true;
+  _litDigits = 0;
+}
+void SegmentGpioDriver::showDigit(byte index, const SegmentPinState& state)
+{
+  // the segments change while every digit is off, only the pins that differ from the last digit
+  setSegments(state, getSegmentLength());
+  setDigitLevel(index, isCommonAnode());
+}
+void SegmentGpioDriver::hideDigit(byte index)
+{
+  hideDigits(index, !isCommonAnode());
+}
+
+void SegmentGpioDriver::invalidate()
+{
+  _segmentsKnown = false;
+}
+bool SegmentGpioDriver::canScanSegments()
+{
+  return true;
+}
+byte SegmentGpioDriver::getSegmentCount()
+{
+  return getSegmentLength();
+}
+void SegmentGpioDriver::showSegment(byte segmentIndex, SEGMENT_MASK_TYPE digits)
+{
+  SegmentPinState state;
+  translate(1 << segmentIndex, state);
+  showSegmentState(state, digits, isCommonAnode(), getSegmentLength());
+}
+void SegmentGpioDriver::hideSegment(byte segmentIndex)
+{
+  setSegments(_blankState, getSegmentLength());
+}
+
+void SegmentGpioDriver::translate(byte b, SegmentPinState& state)
+{
+  // pin levels: a segment is on with high (common cathode) or low (common anode)
+  translateLevels(isCommonAnode() ? ~b : b, state, getSegmentLength());
+}
+
+void SegmentGpioDriver::translateLevels(byte levels, SegmentPinState& state, byte segments)
+{
+#ifdef SEGMENT_FAST_IO
+  if (_segmentPortCount > 0)
+  {
+    // every port word, the unused ones stay 0
+    for (int p = 0; p < MAXSEGMENTPORTS; p++)
+      state.ports[p] = 0;
+
+    // start with the first bit (right)
+    byte pointer = 1;
+    for (int i = 0; i < segments; i++)
+    {
+      if (levels & pointer)
+        state.ports[_segmentPortIndex[i]] |= _segmentBits[i];
+      // move one bit to the left
+      pointer *= 2;
+    }
+    return;
+  }
+#endif
+
+  // without a dp pin, the dp bit is never written
+  state.ports[0] = segments == 8 ? levels : (levels & 0b01111111);
+}
+void SegmentGpioDriver::setSegments(const SegmentPinState& state, byte segments)
+{
+#ifdef SEGMENT_FAST_IO
+  if (_segmentPortCount > 0)
+  {
+    // one write per port, ports without changes are skipped
+    for (int p = 0; p < _segmentPortCount; p++)
+    {
+      SEGMENT_PORT_TYPE changed = _segmentsKnown ? _segmentState.ports[p] ^ state.ports[p] : _segmentPortMasks[p];
+#ifdef SEGMENT_STATS
+      countPins(changed, _segmentPortMasks[p] & ~changed);
+#endif
+      if (changed == 0)
+        continue;
+
+#if defined(__AVR__)
+      uint8_t oldSREG = SREG;
+      cli();
+#endif
+      *_segmentPorts[p] = (*_segmentPorts[p] & ~_segmentPortMasks[p]) | state.ports[p];
+#if defined(__AVR__)
+      SREG = oldSREG;
+#endif
+      _segmentState.ports[p] = state.ports[p];
+    }
+    _segmentsKnown = true;
+    return;
+  }
+#endif
+
+  byte levels = state.ports[0];
+  byte changed = _segmentsKnown ? _segmentState.ports[0] ^ levels : 0xFF;
+#ifdef SEGMENT_STATS
+  countPins(changed, ~changed & ((1 << segments) - 1));
+#endif
+  for (int i = 0; i < segments; i++)
+  {
+    // enable/disable the segment pin, if it changed
+    if ((changed >> i) & 1)
+      digitalWrite(_segmentPins[i], (levels >> i) & 1);
+  }
+  _segmentState.ports[0] = levels;
+  _segmentsKnown = true;
+}
+void SegmentGpioDriver::setDigitLevel(byte index, bool level)
+{
+#ifdef SEGMENT_STATS
+  countPins(1, 0);
+#endif
+
+#ifdef SEGMENT_FAST_IO
+#if defined(__AVR__)
+  uint8_t oldSREG = SREG;
+  cli();
+#endif
+  if (level)
+    *_digitStates[index].port |= _digitStates[index].bit;
+  else
+    *_digitStates[index].port &= ~_digitStates[index].bit;
+#if defined(__AVR__)
+  SREG = oldSREG;
+#endif
+#else
+  digitalWrite(_digitStates[index].pin, level);
+#endif
+}
+void SegmentGpioDriver::hideDigits(byte index, bool offLevel)
+{
+  // the digit line blanks the digit, the segments stay for the next one
+  setDigitLevel(index, offLevel);
+
+  for (int i = 0; _litDigits != 0; i++)
+  {
+    if ((_litDigits >> i) & 1)
+      setDigitLevel(i, offLevel);
+    _litDigits &= ~((SEGMENT_MASK_TYPE)1 << i);
+  }
+}
+void SegmentGpioDriver::showSegmentState(const SegmentPinState& state, SEGMENT_MASK_TYPE digits, bool onLevel, byte segments)
+{
+  // the digit pins only change while every segment is off, only the ones that differ
+  setSegments(_blankState, segments);
+  SEGMENT_MASK_TYPE changed = _litDigits ^ digits;
+  for (int i = 0; i < _displayLength; i++)
+    if ((changed >> i) & 1)
+      setDigitLevel(i, ((digits >> i) & 1) ? onLevel : !onLevel);
+#ifdef SEGMENT_STATS
+  countPins(0, ~changed & (((SEGMENT_MASK_TYPE)1 << (_displayLength - 1) << 1) - 1));
+#endif
+  _litDigits = digits;
+
+  setSegments(state, segments);
+}
+
+void SegmentGpioDriver::resolvePorts()
+{
+#ifdef SEGMENT_FAST_IO
+  // look up the port and bit of every pin once, instead of on every write
+  _segmentPortCount = 0;
+  for (int i = 0; i < getSegmentLength(); i++)
+  {
+    volatile SEGMENT_PORT_TYPE* port = portOutputRegister(digitalPinToPort(_segmentPins[i]));
+    _segmentBits[i] = digitalPinToBitMask(_segmentPins[i]);
+
+    byte p = 0;
+    while (p < _segmentPortCount && _segmentPorts[p] != port)
+      p++;
+    if (p == MAXSEGMENTPORTS)
+    {
+      // more ports than MAXSEGMENTPORTS, the segments use digitalWrite
+      _segmentPortCount = 0;
+      break;
+    }
+    if (p == _segmentPortCount)
+    {
+      _segmentPorts[p] = port;
+      _segmentPortMasks[p] = 0;
+      _segmentPortCount++;
+    }
+    _segmentPortIndex[i] = p;
+    _segmentPortMasks[p] |= _segmentBits[i];
+  }
+
+  for (int i = 0; i < _displayLength; i++)
+  {
+    _digitStates[i].port = portOutputRegister(digitalPinToPort(_digitStates[i].pin));
+    _digitStates[i].bit = digitalPinToBitMask(_digitStates[i].pin);
+  }
+#endif
+}
+int SegmentGpioDriver::getSegmentLength()
+{
+  if (_hasDP)
+    return 8;
+  return 7;
+}
+bool SegmentGpioDriver::isCommonAnode()
+{
+  return _commonPinType == 1;
+}
+
+
+/*
+  --- SHIFT REGISTER ---
+*/
+
+SegmentShiftRegisterDriver::SegmentShiftRegisterDriver(bool commonAnode, int dataPin, int clockPin, int latchPin)
+{
+  _commonAnode = commonAnode;
+  _dataPin = dataPin;
+  _clockPin = clockPin;
+  _latchPin = latchPin;
+}
+
+void SegmentShiftRegisterDriver::begin(SegmentDigit* digits, byte displayLength)
+{
+  _displayLength = displayLength;
+  _shifted = false;
+
+  pinMode(_dataPin, OUTPUT);
+  pinMode(_clockPin, OUTPUT);
+  pinMode(_latchPin, OUTPUT);
+  digitalWrite(_latchPin, LOW);
+  hideDigit(0);
+}
+void SegmentShiftRegisterDriver::translate(byte b, SegmentPinState& state)
+{
+  // the segment register byte: a segment is on with high (common cathode) or low (common anode)
+  state.ports[0] = _commonAnode ? ~b : b;
+}
+void SegmentShiftRegisterDriver::showDigit(byte index, const SegmentPinState& state)
+{
+  // D1 is on Q0 of the digit register, the index starts at the right-most digit
+  byte digits = 1 << (_displayLength - 1 - index);
+  shift(_commonAnode ? digits : ~digits, state.ports[0]);
+}
+void SegmentShiftRegisterDriver::hideDigit(byte index)
+{
+  shift(_commonAnode ? 0 : 0xFF, _commonAnode ? 0xFF : 0);
+}
+void SegmentShiftRegisterDriver::invalidate()
+{
+  _shifted = false;
+}
+bool SegmentShiftRegisterDriver::canScanSegments()
+{
+  return true;
+}
+void SegmentShiftRegisterDriver::showSegment(byte segmentIndex, SEGMENT_MASK_TYPE digits)
+{
+  // bit 0 of the mask is the right-most digit, D1 is on Q0
+  byte outputs = 0;
+  for (int i = 0; i < _displayLength; i++)
+    if ((digits >> i) & 1)
+      outputs |= 1 << (_displayLength - 1 - i);
+
+  byte segments = 1 << segmentIndex;
+  shift(_commonAnode ? outputs : ~outputs, _commonAnode ? ~segments : segments);
+}
+void SegmentShiftRegisterDriver::hideSegment(byte segmentIndex)
+{
+  hideDigit(0);
+}
+void SegmentShiftRegisterDriver::shift(byte digits, byte segments)
+{
+  // the registers have these outputs already
+  if (_shifted && digits == _digits && segments == _segments)
+  {
+#ifdef SEGMENT_STATS
+    countPins(0, 0xFFFF);
+#endif
+    return;
+  }
+#ifdef SEGMENT_STATS
+  countPins(0xFFFF, 0);
+#endif
+  _digits = digits;
+  _segments = segments;
+  _shifted = true;
+
+  // one burst for both registers, the outputs only change on the latch
+  shiftOut(_dataPin, _clockPin, MSBFIRST, digits);
+  shiftOut(_dataPin, _clockPin, MSBFIRST, segments);
+  digitalWrite(_latchPin, HIGH);
+  digitalWrite(_latchPin, LOW);
+}
+
+
+/*
+  --- MAX7219 ---
+*/
+
+SegmentMax7219Driver::SegmentMax7219Driver(int dataPin, int clockPin, int loadPin)
+{
+  _dataPin = dataPin;
+  _clockPin = clockPin;
+  _loadPin = loadPin;
+}
+
+void SegmentMax7219Driver::begin(SegmentDigit* digits, byte displayLength)
+{
+  _displayLength = displayLength > 8 ? 8 : displayLength;
+
+  pinMode(_dataPin, OUTPUT);
+  pinMode(_clockPin, OUTPUT);
+  pinMode(_loadPin, OUTPUT);
+  digitalWrite(_loadPin, HIGH);
+
+  // display test off, no decoding, scan only the used digits, full brightness, leave shutdown
+  writeRegister(0x0F, 0);
+  writeRegister(0x09, 0);
+  writeRegister(0x0B, _displayLength - 1);
+  writeRegister(0x0A, 0x0F);
+  for (int i = 0; i < _displayLength; i++)
+  {
+    _registers[i] = 0;
+    writeRegister(i + 1, 0);
+  }
+  writeRegister(0x0C, 1);
+}
+void SegmentMax7219Driver::translate(byte b, SegmentPinState& state)
+{
+  state.ports[0] = b;
+}
+void SegmentMax7219Driver::showDigit(byte index, const SegmentPinState& state)
+{
+  // the chip scans on its own
+}
+void SegmentMax7219Driver::hideDigit(byte index)
+{
+}
+void SegmentMax7219Driver::setBrightness(byte brightness)
+{
+  // 16 intensity steps
+  writeRegister(0x0A, brightness >> 4);
+}
+bool SegmentMax7219Driver::isSelfScanning()
+{
+  return true;
+}
+void SegmentMax7219Driver::writeFrame(const byte bytes[], byte length)
+{
+  if (length > _displayLength)
+    length = _displayLength;
+
+  for (int i = 0; i < length; i++)
+  {
+    // no-decode bits: dp, a, b, c, d, e, f, g (bit 7 to 0)
+    byte b = bytes[i];
+    byte value = b & 0b10000000;
+    for (int s = 0; s < 7; s++)
+      if (b & (1 << s))
+        value |= 0b01000000 >> s;
+
+    // only send digits that changed, DIG0 (register 1) is D1
+    byte digit = _displayLength - 1 - i;
+    if (_registers[digit] != value)
+    {
+      _registers[digit] = value;
+      writeRegister(digit + 1, value);
+    }
+  }
+}
+void SegmentMax7219Driver::writeRegister(byte address, byte value)
+{
+  digitalWrite(_loadPin, LOW);
+  shiftOut(_dataPin, _clockPin, MSBFIRST, address);
+  shiftOut(_dataPin, _clockPin, MSBFIRST, value);
+  digitalWrite(_loadPin, HIGH);
+}
@@ -0,0 +1,281 @@
+/*
+  DonutStudioSegmentDrivers.h - Output drivers for the seven-segment-display controller.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+/*
+--- drivers ---
+
+  SegmentGpioDriver              segment and digit pins connected to the controller (used by the pin constructors)
+  StaticSegmentGpioDriver        the same with the display type and dp fixed at compile time (used by StaticSegmentController)
+  SegmentShiftRegisterDriver     two chained 74HC595: segments (first) and digits (second), one burst per change
+  SegmentMax7219Driver           MAX7219 (self-scanning), only changed digits are sent
+*/
+
+
+
+#ifndef DonutStudioSegmentDrivers_h
+#define DonutStudioSegmentDrivers_h
+
+
+// write the segment and digit pins directly to their port registers instead of using digitalWrite
+// (AVR by default, any other core that defines portOutputRegister/digitalPinToPort/digitalPinToBitMask can define SEGMENT_FAST_IO, SEGMENT_NO_FAST_IO turns it off)
+#if defined(__AVR__) && !defined(SEGMENT_NO_FAST_IO) && !defined(SEGMENT_FAST_IO)
+#define SEGMENT_FAST_IO
+#endif
+#ifndef SEGMENT_PORT_TYPE
+#define SEGMENT_PORT_TYPE uint8_t
+#endif
+// output ports the segment pins may be spread over, more ports fall back to digitalWrite
+#ifndef MAXSEGMENTPORTS
+#define MAXSEGMENTPORTS 3
+#endif
+// port words of a digit state: one per segment port with the port registers, otherwise only the segment levels
+#ifdef SEGMENT_FAST_IO
+#define SEGMENT_PORT_WORDS MAXSEGMENTPORTS
+#else
+#define SEGMENT_PORT_WORDS 1
+#endif
+// one bit per digit (bit 0 = right-most digit) for the effects and the segment scan, has to hold MAXDIGITS bits
+#ifndef SEGMENT_MASK_TYPE
+#define SEGMENT_MASK_TYPE uint16_t
+#endif
+// define SEGMENT_STATS to count the pins written by the drivers and the writes they skipped (pin already at the level)
+
+
+#include "Arduino.h"
+
+// the output states of one digit, translated by the driver from its byte once per frame:
+// e.g. the output word of every segment port, or the pin levels of the segments (bit 0 = a)
+struct SegmentPinState
+{
+  SEGMENT_PORT_TYPE ports[SEGMENT_PORT_WORDS];
+};
+
+// everything the controller keeps per digit, indexed from the right-most digit
+struct SegmentDigit
+{
+  // digit pin (SegmentGpioDriver)
+  int pin;
+  // byte written by the set functions, the overlay (segments added) and the mask (segments taken out of the content)
+  byte content;
+  byte overlay;
+  byte mask;
+  // output states of the two frames (front/pending)
+  SegmentPinState frames[2];
+  // bytes of the two frames (layers combined) and the lit segments of the front frame (counted once per frame)
+  byte bytes[2];
+  byte lit;
+  // brightness set by the user and its on-time in bit planes (gamma corrected, 0 to SEGMENT_BCM_LEVELS)
+  byte brightness;
+  byte level;
+#ifdef SEGMENT_FAST_IO
+  volatile SEGMENT_PORT_TYPE* port;
+  SEGMENT_PORT_TYPE bit;
+#endif
+};
+
+
+// interface between the controller and the hardware
+class SegmentDriver
+{
+  public:
+    // set up the outputs for the digits of a display
+    virtual void begin(SegmentDigit* digits, byte displayLength) = 0;
+    // translate the byte of a digit (bit 0 = a) into the states written by showDigit, called once per frame
+    virtual void translate(byte b, SegmentPinState& state) = 0;
+    // light a digit (index from the right-most digit)
+    virtual void showDigit(byte index, const SegmentPinState& state) = 0;
+    // turn a digit off again
+    virtual void hideDigit(byte index) = 0;
+    // forget the outputs cached by the driver, e.g. after another display wrote the shared segment pins
+    virtual void invalidate() { }
+    // set the brightness of hardware that dims on its own (scanned displays are dimmed by the controller)
+    virtual void setBrightness(byte brightness) { }
+
+    // check if the hardware scans the digits on its own, the controller then only hands over frames with writeFrame
+    virtual bool isSelfScanning() { return false; }
+    // hand over the bytes of all digits (from the right-most digit), called whenever the display might have changed
+    virtual void writeFrame(const byte bytes[], byte length) { }
+
+    // check if the driver can light one segment on several digits at once (segment scan)
+    virtual bool canScanSegments() { return false; }
+    // get the amount of segment lines (phases of the segment scan)
+    virtual byte getSegmentCount() { return 8; }
+    // light a segment (0 = a) on every digit of the mask (bit 0 = right-most digit)
+    virtual void showSegment(byte segmentIndex, SEGMENT_MASK_TYPE digits) { }
+    // turn a segment off again
+    virtual void hideSegment(byte segmentIndex) { }
+
+#ifdef SEGMENT_STATS
+    // get the amount of pins written
+    unsigned long getPinWrites() { return _pinWrites; }
+    // get the amount of pin writes skipped because the pin had the level already
+    unsigned long getSkippedPinWrites() { return _skippedPinWrites; }
+    void resetPinStats() { _pinWrites = 0; _skippedPinWrites = 0; }
+
+  protected:
+    // count the set bits of both masks as written/skipped pins
+    void countPins(unsigned long written, unsigned long skipped)
+    {
+      for (; written != 0; written &= written - 1)
+        _pinWrites++;
+      for (; skipped != 0; skipped &= skipped - 1)
+        _skippedPinWrites++;
+    }
+
+  private:
+    unsigned long _pinWrites = 0;
+    unsigned long _skippedPinWrites = 0;
+#endif
+};
+
+
+// segment and digit pins connected to the controller
+class SegmentGpioDriver : public SegmentDriver
+{
+  public:
+    SegmentGpioDriver();
+    SegmentGpioDriver(bool commonAnode, bool hasDP, int segmentPins[8]);
+
+    void begin(SegmentDigit* digits, byte displayLength);
+    void translate(byte b, SegmentPinState& state);
+    void showDigit(byte index, const SegmentPinState& state);
+    void hideDigit(byte index);
+    void invalidate();
+
+    bool canScanSegments();
+    byte getSegmentCount();
+    void showSegment(byte segmentIndex, SEGMENT_MASK_TYPE digits);
+    void hideSegment(byte segmentIndex);
+
+  protected:
+    // the writes without the display type: levels of the segment pins (a segment is on with high for common cathode, low for common anode),
+    // a digit pin, the digit and the ones left on by the segment scan turned off, the digit pins of a segment line
+    void translateLevels(byte levels, SegmentPinState& state, byte segments);
+    void setSegments(const SegmentPinState& state, byte segments);
+    void setDigitLevel(byte index, bool level);
+    void hideDigits(byte index, bool offLevel);
+    void showSegmentState(const SegmentPinState& state, SEGMENT_MASK_TYPE digits, bool onLevel, byte segments);
+
+    // segment outputs with every segment off
+    SegmentPinState _blankState;
+
+  private:
+    void resolvePorts();
+
+    int getSegmentLength();
+    bool isCommonAnode();
+
+    // display type: common cathode = 0, command anode = 1
+    int _commonPinType = 0;
+    // a, b, c, d, e, f, g, dp
+    int _segmentPins[8];
+    bool _hasDP = true;
+
+    SegmentDigit* _digitStates;
+    byte _displayLength = 0;
+    // segment outputs as last written, only changed pins are written again
+    SegmentPinState _segmentState;
+    bool _segmentsKnown = false;
+    // digit pins left on by the segment scan
+    SEGMENT_MASK_TYPE _litDigits = 0;
+#ifdef SEGMENT_FAST_IO
+    // output registers used by the segment pins and the pins of every segment on them (no ports: too many, use digitalWrite)
+    volatile SEGMENT_PORT_TYPE* _segmentPorts[MAXSEGMENTPORTS];
+    SEGMENT_PORT_TYPE _segmentPortMasks[MAXSEGMENTPORTS];
+    byte _segmentPortCount = 0;
+    // port (index of _segmentPorts) and bit of every segment
+    byte _segmentPortIndex[8];
+    SEGMENT_PORT_TYPE _segmentBits[8];
+#endif
+};
+
+
+// segment and digit pins with the display type and the dp fixed at compile time: the writes of the scan have no display type branches
+template <bool CommonAnode, bool HasDP = true>
+class StaticSegmentGpioDriver : public SegmentGpioDriver
+{
+  public:
+    StaticSegmentGpioDriver(int segmentPins[8]) : SegmentGpioDriver(CommonAnode, HasDP, segmentPins) { }
+
+    void translate(byte b, SegmentPinState& state) { translateLevels(CommonAnode ? ~b : b, state, Segments); }
+    void showDigit(byte index, const SegmentPinState& state)
+    {
+      setSegments(state, Segments);
+      setDigitLevel(index, CommonAnode);
+    }
+    void hideDigit(byte index) { hideDigits(index, !CommonAnode); }
+
+    byte getSegmentCount() { return Segments; }
+    void showSegment(byte segmentIndex, SEGMENT_MASK_TYPE digits)
+    {
+      SegmentPinState state;
+      translateLevels(CommonAnode ? ~(1 << segmentIndex) : 1 << segmentIndex, state, Segments);
+      showSegmentState(state, digits, CommonAnode, Segments);
+    }
+    void hideSegment(byte segmentIndex) { setSegments(_blankState, Segments); }
+
+  private:
+    static const byte Segments = HasDP ? 8 : 7;
+};
+
+
+// two chained 74HC595: the first one drives the segments (Q0 = a ... Q7 = dp), the second one the digits (Q0 = D1, Q1 = D2, ...)
+class SegmentShiftRegisterDriver : public SegmentDriver
+{
+  public:
+    SegmentShiftRegisterDriver(bool commonAnode, int dataPin, int clockPin, int latchPin);
+
+    void begin(SegmentDigit* digits, byte displayLength);
+    void translate(byte b, SegmentPinState& state);
+    void showDigit(byte index, const SegmentPinState& state);
+    void hideDigit(byte index);
+    void invalidate();
+
+    bool canScanSegments();
+    void showSegment(byte segmentIndex, SEGMENT_MASK_TYPE digits);
+    void hideSegment(byte segmentIndex);
+
+  private:
+    void shift(byte digits, byte segments);
+
+    bool _commonAnode;
+    // register bytes as last shifted out, the same bytes aren't sent again
+    byte _digits = 0;
+    byte _segments = 0;
+    bool _shifted = false;
+    int _dataPin;
+    int _clockPin;
+    int _latchPin;
+    byte _displayLength = 0;
+};
+
+
+// MAX7219 in no-decode mode: scans up to 8 digits on its own (DIG0 = D1, DIG1 = D2, ...)
+class SegmentMax7219Driver : public SegmentDriver
+{
+  public:
+    SegmentMax7219Driver(int dataPin, int clockPin, int loadPin);
+
+    void begin(SegmentDigit* digits, byte displayLength);
+    void translate(byte b, SegmentPinState& state);
+    void showDigit(byte index, const SegmentPinState& state);
+    void hideDigit(byte index);
+    void setBrightness(byte brightness);
+
+    bool isSelfScanning();
+    void writeFrame(const byte bytes[], byte length);
+
+  private:
+    void writeRegister(byte address, byte value);
+
+    int _dataPin;
+    int _clockPin;
+    int _loadPin;
+    byte _displayLength = 0;
+    // digit registers as last sent to the chip
+    byte _registers[8];
+};
+#endif
@@ -0,0 +1,157 @@
+/*
+  DonutStudioSegmentScheduler.h - Scan several seven-segment-displays that share their segment pins.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "Arduino.h"
+#include "DonutStudioSegmentScheduler.h"
+
+/*
+  --- CONSTRUCTOR ---
+*/
+
+SegmentScheduler::SegmentScheduler(byte refreshTime)
+{
+  _refreshTime = refreshTime;
+  _phaseTime = refreshTime * 1000UL;
+}
+
+
+/*
+  --- PUBLIC METHODS ---
+*/
+
+bool SegmentScheduler::addDisplay(SegmentControllerBase& display)
+{
+  if (_displayCount >= MAXDISPLAYS)
+    return false;
+  hideSlot();
+
+  _displays[_displayCount++] = &display;
+  _digitCount += display._displayLength;
+  if (display._displayLength > _maxLength)
+    _maxLength = display._displayLength;
+
+  // start over with the first digit of the first display
+  _slotDisplay = _displayCount - 1;
+  _slotDigit = _maxLength - 1;
+  _scanPlane = 0;
+  return true;
+}
+byte SegmentScheduler::getDisplayCount()
+{
+  return _displayCount;
+}
+byte SegmentScheduler::getDigitCount()
+{
+  return _digitCount;
+}
+
+void SegmentScheduler::refresh()
+{
+  update();
+
+  // move to the next phase (slot or bit plane) once the current one is over, never wait
+  unsigned long now = micros();
+  if (now - _slotStart < _phaseTime)
+    return;
+
+  // keep the grid, but skip missed phases instead of catching up
+  _slotStart += _phaseTime;
+  if (now - _slotStart >= _phaseTime)
+    _slotStart = now;
+  _phaseTime = scan();
+}
+void SegmentScheduler::update()
+{
+  for (int i = 0; i < _displayCount; i++)
+    _displays[i]->update();
+}
+unsigned long SegmentScheduler::scan()
+{
+  if (_displayCount == 0)
+    return _refreshTime * 1000UL;
+
+  // a new slot once all bit planes of the current one are over
+  if (_scanPlane == 0)
+  {
+    hideSlot();
+
+    // disabled digits don't get a slot (at most one round if all of them are disabled)
+    for (int i = 0; i < _displayCount * _maxLength; i++)
+    {
+      if (nextSlot())
+        break;
+    }
+    SegmentControllerBase* display = _displays[_slotDisplay];
+    _slotDimmed = _slotDigit < display->_displayLength && ((display->_dimmedDigits >> _slotDigit) & 1);
+    _scanPlane = _slotDimmed ? SEGMENT_BCM_BITS : 1;
+  }
+  _scanPlane--;
+
+  // a digit lit in the previous plane stays lit
+  SegmentControllerBase* display = _displays[_slotDisplay];
+  bool lit = _slotDimmed ? (display->_planeDigits[_scanPlane] >> _slotDigit) & 1 : display->isDigitVisible(_slotDigit);
+  if (!lit)
+    hideSlot();
+  else if (!_slotLit)
+  {
+    // the shared segment pins were written by another display
+    if (_slotDisplay != _shownDisplay)
+      display->_driver->invalidate();
+    _shownDisplay = _slotDisplay;
+    display->showDigit(_slotDigit);
+    _slotLit = true;
+  }
+
+  // the planes of a dimmed digit take 1, 2, 4, ... units of the slot
+  unsigned long slotTime = _refreshTime * 1000UL;
+  if (_slotDimmed)
+    return (slotTime / SEGMENT_BCM_LEVELS) << _scanPlane;
+  return slotTime;
+}
+
+void SegmentScheduler::setRefreshTime(byte refreshTime)
+{
+  _refreshTime = refreshTime;
+  _phaseTime = refreshTime * 1000UL;
+}
+byte SegmentScheduler::getRefreshTime()
+{
+  return _refreshTime;
+}
+
+
+/*
+  --- PRIVATE METHODS ---
+*/
+
+void SegmentScheduler::hideSlot()
+{
+  if (!_slotLit)
+    return;
+  _displays[_slotDisplay]->hideDigit(_slotDigit);
+  _slotLit = false;
+}
+bool SegmentScheduler::nextSlot()
+{
+  // next display, then the next digit
+  _slotDisplay++;
+  if (_slotDisplay >= _displayCount)
+  {
+    _slotDisplay = 0;
+    _slotDigit++;
+    if (_slotDigit >= _maxLength)
+    {
+      _slotDigit = 0;
+
+      // a new frame starts on all displays at the same time
+      for (int i = 0; i < _displayCount; i++)
+        _displays[i]->startFrame();
+    }
+  }
+
+  SegmentControllerBase* display = _displays[_slotDisplay];
+  return _slotDigit < display->_displayLength && ((display->_enabledDigits >> _slotDigit) & 1);
+}
@@ -0,0 +1,82 @@
+/*
+  DonutStudioSegmentScheduler.h - Scan several seven-segment-displays that share their segment pins.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+/*
+--- shared segment bus ---
+
+  a, b, c, d, e, f, g, dp  ->  display 1 (D1 - D4)
+                           ->  display 2 (D1 - D4)
+                           ->  ...
+
+  every display has its own digit pins, only one digit of all displays is lit at a time
+  a dimmed digit is lit in the bit planes of its brightness (binary code modulation) within its slot, like on a single display
+*/
+
+
+
+#ifndef DonutStudioSegmentScheduler_h
+#define DonutStudioSegmentScheduler_h
+
+#ifndef MAXDISPLAYS
+#define MAXDISPLAYS 4
+#endif
+
+
+#include "Arduino.h"
+#include "DonutStudioSevenSegment.h"
+
+class SegmentScheduler
+{
+  public:
+    SegmentScheduler(byte refreshTime);
+
+    // add a display to the scan (false if MAXDISPLAYS displays were added already), the scheduler refreshes it from now on
+    bool addDisplay(SegmentControllerBase& display);
+    // get the amount of displays
+    byte getDisplayCount();
+    // get the amount of digits of all displays
+    byte getDigitCount();
+
+    // update all displays and light the next digit once the current slot is over, never waits
+    void refresh();
+    // update all displays (scroller, new frames) without scanning, use with scan() from a timer interrupt
+    void update();
+    // move the scan to the next digit (or bit plane of a dimmed digit) of all displays and return the time (in microseconds) until the next call,
+    // safe to call from a timer interrupt (reload the timer with the returned time)
+    unsigned long scan();
+
+    // set the time (in milliseconds) every digit is lit
+    void setRefreshTime(byte refreshTime);
+    // get the time (in milliseconds) every digit is lit
+    byte getRefreshTime();
+
+
+  private:
+    void hideSlot();
+    bool nextSlot();
+
+    SegmentControllerBase* _displays[MAXDISPLAYS];
+    byte _displayCount = 0;
+    byte _digitCount = 0;
+    // length of the longest display
+    byte _maxLength = 0;
+
+    // time (in milliseconds) every digit is lit, start and time (in microseconds) of the current phase
+    byte _refreshTime = 2;
+    unsigned long _slotStart = 0;
+    unsigned long _phaseTime = 2000;
+
+    // current slot: digit (index from the right) of a display, the digits are interleaved (right-most digit of all displays, the next one of all displays, ...)
+    volatile byte _slotDigit = 0;
+    volatile byte _slotDisplay = 0;
+    volatile bool _slotLit = false;
+    // bit plane of a dimmed digit (counting down, 0 = last one) and if the digit of the slot is dimmed
+    volatile byte _scanPlane = 0;
+    volatile bool _slotDimmed = false;
+    // display that lit a digit last
+    byte _shownDisplay = MAXDISPLAYS;
+};
+#endif
@@ -24,41 +24,96 @@
 
 #include "Arduino.h"
 #include "DonutStudioSevenSegment.h"
+#include <stdarg.h>
+
+/*
+  --- FONT ---
+*/
+
+// shared by all instances and kept in flash
+const byte SegmentControllerBase::_digits[11] PROGMEM = { SEGMENT_FONT_DIGITS };
+const byte SegmentControllerBase::_alphabet[26] PROGMEM = { SEGMENT_FONT_ALPHABET };
+const byte SegmentControllerBase::_specialCharacters[13] PROGMEM = { SEGMENT_FONT_SPECIAL_CHARACTERS };
+// 255 * ((i + 1) / 32)^2.2
+const byte SegmentControllerBase::_gamma[32] PROGMEM = { 0, 1, 1, 3, 4, 6, 9, 12, 16, 20, 24, 29, 35, 41, 48, 55, 63, 72, 81, 91, 101, 112, 123, 135, 148, 161, 175, 190, 205, 221, 238, 255 };
 
 /*
   --- CONSTRUCTOR ---
 */
 
-SegmentController::SegmentController(bool commonAnode, int segmentPins[8], int digitPins[], byte displayLength, byte refreshTime)
+SegmentController::SegmentController(bool commonAnode, int segmentPins[8], int digitPins[], byte displayLength, byte refreshTime) : _gpio(commonAnode, segmentPins[7] > 0, segmentPins)
 {
-  _commonPinType = commonAnode ? 1 : 0;
-  _hasDP = segmentPins[7] > 0;
-  _refreshTime = refreshTime;
+  initialize(_storage, &_gpio, digitPins, displayLength > MAXDIGITS ? MAXDIGITS : displayLength, refreshTime);
+}
+SegmentController::SegmentController(const SegmentController& other) : SegmentControllerBase(other), _gpio(other._gpio)
+{
+  *this = other;
+}
+SegmentController& SegmentController::operator=(const SegmentController& other)
+{
+  SegmentControllerBase::operator=(other);
+  for (int i = 0; i < MAXDIGITS; i++)
+    _storage[i] = other._storage[i];
+  // the digits and the gpio driver are kept in this instance, not the copied one
+  _digitStates = _storage;
+  _gpio = other._gpio;
+  _driver = &_gpio;
+  _gpio.begin(_storage, _displayLength);
+  return *this;
+}
 
-  _displayLength = displayLength;
-  if (_displayLength > MAXDIGITS)
-    _displayLength = MAXDIGITS;
+SegmentDriverController::SegmentDriverController(SegmentDriver& driver, byte displayLength, byte refreshTime)
+{
+  initialize(_storage, &driver, NULL, displayLength > MAXDIGITS ? MAXDIGITS : displayLength, refreshTime);
+}
+SegmentDriverController::SegmentDriverController(const SegmentDriverController& other) : SegmentControllerBase(other)
+{
+  *this = other;
+}
+SegmentDriverController& SegmentDriverController::operator=(const SegmentDriverController& other)
+{
+  SegmentControllerBase::operator=(other);
+  for (int i = 0; i < MAXDIGITS; i++)
+    _storage[i] = other._storage[i];
+  // the digits are kept in this instance, the driver is shared with the copied one
+  _digitStates = _storage;
+  return *this;
+}
 
+void SegmentControllerBase::initialize(SegmentDigit* digits, SegmentDriver* driver, int digitPins[], byte displayLength, byte refreshTime)
+{
+  _digitStates = digits;
+  _driver = driver;
+  _refreshTime = refreshTime;
+  _displayLength = displayLength;
+  setSlotTime(_refreshTime * 1000UL);
+  _phaseTime = _slotTime;
 
-  // set the segment pins
-  for (int i = 0; i < 8; i++)
+  // digit pins in ascending order (D1, D2, ...), only used by the gpio driver
+  for (int i = 0; i < _displayLength; i++)
   {
-    _segmentPins[i] = segmentPins[i];
-    pinMode(_segmentPins[i], OUTPUT);
-    digitalWrite(_segmentPins[i], 1 - _commonPinType);
+    _digitStates[i].pin = digitPins != NULL ? digitPins[_displayLength - 1 - i] : -1;
+    _digitStates[i].brightness = 255;
+    _digitStates[i].level = SEGMENT_BCM_LEVELS;
+    _digitStates[i].content = pgm_read_byte(&_digits[10]);
+    _digitStates[i].overlay = 0;
+    _digitStates[i].mask = 0;
   }
-  
-  // set the digit pins
+
+  _driver->begin(_digitStates, _displayLength);
+
+  SegmentPinState blank;
+  _driver->translate(pgm_read_byte(&_digits[10]), blank);
   for (int i = 0; i < _displayLength; i++)
   {
-    _digitPins[i] = digitPins[_displayLength - 1 - i];
-    pinMode(_digitPins[i], OUTPUT);
-    digitalWrite(_digitPins[i], 1 - _commonPinType);
-
-    _digitBlinking[i] = false;
-    _digitEnabled[i] = true;
-    _displayedBytes[i] = _digits[10];
+    _digitStates[i].frames[0] = blank;
+    _digitStates[i].frames[1] = blank;
+    _digitStates[i].bytes[0] = pgm_read_byte(&_digits[10]);
+    _digitStates[i].bytes[1] = pgm_read_byte(&_digits[10]);
   }
+  _frontFrame = 0;
+  updateEffects();
+  setScanMode(_scanMode);
 }
 
 
@@ -68,48 +123,252 @@ SegmentController::SegmentController(bool commonAnode, int segmentPins[8], int d
 
 /*-- MAIN --*/
 
-void SegmentController::refresh()
+void SegmentControllerBase::refresh()
 {
-  if (_isScrolling)
-    updateScroller();
+#ifdef SEGMENT_STATS
+  unsigned long start = micros();
+#endif
+  update();
 
-  for (int i = 0; i < _displayLength; i++)
+  // the timer interrupt (or the hardware) does the scanning
+  if (_refreshMode == REFRESH_INTERRUPT || _driver->isSelfScanning())
   {
-    if (!_digitEnabled[_displayLength - 1 - i])
-      continue;
-    else if (_digitBlinking[_displayLength - 1 - i] && (millis() % (_blinkInterval * 2) > _blinkInterval))
+  }
+  else if (_refreshMode == REFRESH_NONBLOCKING)
+  {
+    // move to the next phase once the current one is over, never wait
+    unsigned long now = micros();
+    if (now - _slotStart >= _phaseTime)
     {
-      delay(_refreshTime);
-      continue;
+      // keep the phase grid, but skip missed phases instead of catching up
+      _slotStart += _phaseTime;
+      if (now - _slotStart >= _phaseTime)
+      {
+        _slotStart = now;
+#ifdef SEGMENT_STATS
+        _statsMissedDeadlines++;
+#endif
+      }
+      _phaseTime = scan();
     }
-    
-    // enable
-    analogWrite(_digitPins[i],  isCommonAnode() ? (_brightness) : (byte)(255 - _brightness));
-    setSegments(_displayedBytes[i]);
-    
-    delay(_refreshTime);
-    
-    // disable
-    analogWrite(_digitPins[i], 255 * (1 - _commonPinType));
-    setSegments(_digits[10]);
+  }
+  else
+  {
+    // one full scan, waiting for every phase
+    hideSlot();
+    resetScan();
+    do
+      wait(scan());
+    while (_scanSlot != getSlotCount(_segmentScan) - 1 || _scanPlane != 0 || _scanPart + 1 < _slotParts);
+    hideSlot();
   }
 
-  delay(_refreshTime);
+#ifdef SEGMENT_STATS
+  unsigned long time = micros() - start;
+  _statsRefreshTime += time;
+  if (time > _statsMaxRefreshTime)
+    _statsMaxRefreshTime = time;
+#endif
 }
-void SegmentController::clear()
+void SegmentControllerBase::setRefreshMode(byte mode)
 {
-  disableScroller();
-  setSegments(_digits[10]);
-  for (int i = 0; i < _displayLength; i++)
+  hideSlot();
+  _refreshMode = mode;
+  resetScan();
+  _slotStart = micros();
+  _phaseTime = _slotTime;
+}
+byte SegmentControllerBase::getRefreshMode()
+{
+  return _refreshMode;
+}
+unsigned long SegmentControllerBase::scan()
+{
+#ifdef SEGMENT_STATS
+  // time since the previous phase
+  unsigned long now = micros();
+  if (_statsScans > 0)
+  {
+    unsigned long gap = now - _statsLastScan;
+    _statsGapSum += gap;
+    if (gap > _statsMaxGap)
+      _statsMaxGap = gap;
+  }
+  _statsLastScan = now;
+  _statsScans++;
+#endif
+
+  // a slot with more lit LEDs than the segment limit is split into parts, a part of a dimmed digit into bit planes (binary code modulation)
+  if (_scanPlane == 0)
+  {
+    hideSlot();
+    if (_scanPart + 1 < _slotParts)
+      _scanPart++;
+    else
+    {
+      nextSlot();
+      _scanPart = 0;
+    }
+    _partBits = _slotParts > 1 ? getPart(_slotBits, _scanPart, _segmentLimit) : _slotBits;
+    _scanPlane = _slotDimmed ? SEGMENT_BCM_BITS : 1;
+  }
+  _scanPlane--;
+
+  if (_segmentScan)
+  {
+    SEGMENT_MASK_TYPE digits = _partBits & (_slotDimmed ? _planeDigits[_scanPlane] : _visibleDigits);
+    hideSlot();
+    if (digits != 0)
+    {
+      _driver->showSegment(_scanSlot, digits);
+      _slotLit = true;
+    }
+  }
+  else
+  {
+    // a digit lit in the previous plane stays lit
+    bool lit = _scanSlot < _displayLength && ((_slotDimmed ? _planeDigits[_scanPlane] : _visibleDigits) >> _scanSlot) & 1;
+    if (!lit)
+      hideSlot();
+    else if (!_slotLit)
+    {
+      // a part of a digit is translated here, whole digits were translated with the frame
+      if (_slotParts > 1)
+      {
+        SegmentPinState state;
+        _driver->translate(_partBits, state);
+        _driver->showDigit(_scanSlot, state);
+      }
+      else
+        showDigit(_scanSlot);
+      _slotLit = true;
+    }
+  }
+
+  if (_slotDimmed)
+    return (_planeTime << _scanPlane) / _slotParts;
+  return _slotTime / _slotParts;
+}
+void SegmentControllerBase::setScanMode(byte mode)
+{
+  noInterrupts();
+  hideSlot();
+  _scanMode = mode;
+
+  // the segment scan needs the driver
+  bool possible = _driver->canScanSegments();
+  // auto: the mode with fewer slots lights every segment longer and repeats the frame more often
+  if (mode == SCAN_AUTO)
+    _segmentScan = possible && getSlotCount(true) < getSlotCount(false);
+  else
+    _segmentScan = possible && mode == SCAN_SEGMENTS;
+
+  resetScan();
+  _slotStart = micros();
+  interrupts();
+}
+byte SegmentControllerBase::getScanMode()
+{
+  return _scanMode;
+}
+bool SegmentControllerBase::isScanningSegments()
+{
+  return _segmentScan;
+}
+void SegmentControllerBase::setFrameRate(unsigned int frameRate, unsigned int minFrameRate)
+{
+  noInterrupts();
+  _frameRate = frameRate;
+  _minFrameRate = minFrameRate;
+  // start with the slot time of a frame without any delay, the measured frames correct it
+  if (frameRate == 0)
+    setSlotTime(_refreshTime * 1000UL);
+  else
+    setSlotTime(1000000UL / frameRate / getSlotCount(_segmentScan));
+  _frameStart = micros();
+  interrupts();
+}
+unsigned int SegmentControllerBase::getFrameRate()
+{
+  return _frameRate;
+}
+unsigned long SegmentControllerBase::getSlotTime()
+{
+  return _slotTime;
+}
+void SegmentControllerBase::setSegmentEqualization(bool value)
+{
+  _segmentEqualization = value;
+}
+bool SegmentControllerBase::getSegmentEqualization()
+{
+  return _segmentEqualization;
+}
+void SegmentControllerBase::setSegmentLimit(byte maxSegments)
+{
+  _segmentLimit = maxSegments;
+}
+byte SegmentControllerBase::getSegmentLimit()
+{
+  return _segmentLimit;
+}
+#ifdef SEGMENT_STATS
+SegmentStats SegmentControllerBase::getStats()
+{
+  SegmentStats stats;
+  noInterrupts();
+  unsigned long time = micros() - _statsStart;
+  stats.frames = _statsFrames;
+  stats.frameRate = time > 0 ? _statsFrames * 1000000.0 / time : 0;
+  stats.maxScanGap = _statsMaxGap;
+  stats.averageScanGap = _statsScans > 1 ? _statsGapSum / (_statsScans - 1) : 0;
+  stats.missedDeadlines = _statsMissedDeadlines;
+  stats.refreshTime = _statsRefreshTime;
+  stats.maxRefreshTime = _statsMaxRefreshTime;
+  stats.droppedScrollSteps = _statsDroppedScrollSteps;
+  interrupts();
+  stats.pinWrites = _driver->getPinWrites();
+  stats.skippedPinWrites = _driver->getSkippedPinWrites();
+  return stats;
+}
+void SegmentControllerBase::resetStats()
+{
+  noInterrupts();
+  _statsStart = micros();
+  _statsFrames = 0;
+  _statsScans = 0;
+  _statsGapSum = 0;
+  _statsMaxGap = 0;
+  _statsMissedDeadlines = 0;
+  _statsRefreshTime = 0;
+  _statsMaxRefreshTime = 0;
+  _statsDroppedScrollSteps = 0;
+  interrupts();
+  _driver->resetPinStats();
+}
+#endif
+void SegmentControllerBase::clear()
+{
+  stopAnimations();
+  _printCursor = 0;
+  _printOverflow = false;
+  // the pins belong to the interrupt in REFRESH_INTERRUPT, it picks up the empty frame on its own
+  if (_refreshMode != REFRESH_INTERRUPT)
   {
-    analogWrite(_digitPins[i], 255 * (1 - _commonPinType));
-    _displayedBytes[i] = _digits[10];
+    _slotLit = false;
+    for (int i = 0; i < _displayLength; i++)
+      _driver->hideDigit(i);
   }
+
+  for (int i = 0; i < _displayLength; i++)
+    _digitStates[i].content = pgm_read_byte(&_digits[10]);
+  _frameDirty = true;
 }
-void SegmentController::transform(int shift)
+void SegmentControllerBase::transform(int shift)
 {
   if (shift == 0)
     return;
+  _frameDirty = true;
 
   // positive shift -> right
   if (shift > 0) 
@@ -120,269 +379,501 @@ void SegmentController::transform(int shift)
     for (int i = _displayLength - 1; i >= 0; i--)
       transformDigit(i, shift);
 }
-void SegmentController::setBrightness(byte brightness)
+void SegmentControllerBase::setBrightness(byte brightness)
 {
   _brightness = brightness;
+  for (int i = 0; i < _displayLength; i++)
+  {
+    _digitStates[i].brightness = brightness;
+    _digitStates[i].level = getLevel(brightness);
+  }
+  // self-scanning hardware dims on its own
+  _driver->setBrightness(brightness);
 }
-byte SegmentController::getBrightness()
+byte SegmentControllerBase::getBrightness()
 {
   return _brightness;
 }
+void SegmentControllerBase::setDigitBrightness(byte digitIndex, byte brightness)
+{
+  if (!isDigitInRange(digitIndex))
+    return;
+  _digitStates[_displayLength - 1 - digitIndex].brightness = brightness;
+  _digitStates[_displayLength - 1 - digitIndex].level = getLevel(brightness);
+}
+byte SegmentControllerBase::getDigitBrightness(byte digitIndex)
+{
+  if (!isDigitInRange(digitIndex))
+    return 0;
+  return _digitStates[_displayLength - 1 - digitIndex].brightness;
+}
 
 
 /*-- DISPLAY --*/
 
-void SegmentController::setByte(byte b[])
+void SegmentControllerBase::setByte(byte b[])
 {
-  disableScroller();
+  stopAnimations();
 
   for (int i = 0; i < _displayLength; i++)
-    _displayedBytes[i] = b[_displayLength - i - 1];
+    _digitStates[i].content = b[_displayLength - i - 1];
+  _frameDirty = true;
 }
-void SegmentController::setInt(int number, bool showLeadZeros)
+void SegmentControllerBase::setByte_P(const byte b[])
 {
-  if (!isNumberInRange(number))
-    return;
-  disableScroller();
-  
-  bool lead = !showLeadZeros;
-  bool negativ = number < 0;
-  if (negativ)
-    number *= -1;
+  stopAnimations();
 
-  for (int i = _displayLength - 1; i >= 0 ; i--)
-  {
-    if (negativ && !lead && i == _displayLength - 1)
-    {
-      _displayedBytes[i] = getMinus();
-      negativ = false;
-      continue;
-    }
-
-    byte digit = (int)(number / pow(10, i)) % 10;
-    if (negativ && digit == 0 && i > 0)
-    {
-      byte d = (int)(number / pow(10, i - 1)) % 10;
-      if (d != 0)
-      {
-        _displayedBytes[i] = getMinus();
-        negativ = false;
-      }
-    }
-    else if (lead && digit == 0)
-      _displayedBytes[i] = _digits[10];
-    else
-    {
-      _displayedBytes[i] = _digits[digit];
-      lead = false;
-    }
-  }
+  for (int i = 0; i < _displayLength; i++)
+    _digitStates[i].content = pgm_read_byte(&b[_displayLength - i - 1]);
+  _frameDirty = true;
+}
+void SegmentControllerBase::setInt(long number, bool showLeadZeros)
+{
+  setNumber(number, DEC, showLeadZeros);
+}
+void SegmentControllerBase::setUnsigned(unsigned long number, bool showLeadZeros)
+{
+  formatNumber(number, false, DEC, showLeadZeros ? _displayLength : 1, false);
+}
+void SegmentControllerBase::setHex(unsigned long number, bool showLeadZeros)
+{
+  formatNumber(number, false, HEX, showLeadZeros ? _displayLength : 1, false);
+}
+void SegmentControllerBase::setBinary(unsigned long number, bool showLeadZeros)
+{
+  formatNumber(number, false, BIN, showLeadZeros ? _displayLength : 1, false);
+}
+void SegmentControllerBase::setNumber(long number, byte base, bool showLeadZeros, bool alignLeft)
+{
+  bool negativ = number < 0;
+  // the minus takes the place of a lead zero
+  byte minDigits = showLeadZeros ? _displayLength - (negativ ? 1 : 0) : 1;
+  formatNumber(negativ ? 0UL - (unsigned long)number : (unsigned long)number, negativ, base, minDigits, alignLeft);
 }
 
-/*
-void SegmentController::setFloat(float number)
+void SegmentControllerBase::setFloat(float number, byte decimals)
 {
   if (!isNumberInRange(number))
     return;
-  disableScroller();
+  if (decimals >= _displayLength)
+    decimals = _displayLength - 1;
 
-  bool negativ = number < 0;
-  if (negativ)
-    number *= -1;
+  unsigned long factor = 1;
+  for (int i = 0; i < decimals; i++)
+    factor *= 10;
 
-  int exponent = 0;
-  for (int i = -_displayLength + 2; i <= _displayLength; i++)
+  // a scaled number with more digits than the display can't fit and may not even fit into a long (32 bit on an AVR)
+  float magnitude = number < 0 ? -number : number;
+  float limit = (float)getNumberLimit();
+  while (decimals > 0 && magnitude * factor >= limit)
   {
-    if (number < pow(10, i))
-    {
-      exponent = i - 1;
-      break;
-    }
+    factor /= 10;
+    decimals--;
   }
-  
-  int dotIndex = _displayLength - 1;
-  if (exponent > 0)
-    dotIndex -= exponent;
 
-  setInt(round(number * pow(10, dotIndex)));
-  setDigitSegment(_displayLength - 1 - dotIndex, 7, true);
-  if (negativ)
-    setDigit(0, getMinus());
+  // the only float operation, everything after is integer math
+  float scaled = number * factor;
+  long value = (long)(scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+
+  // drop decimals (rounded) until the number fits
+  while (!formatFixed(value, decimals) && decimals > 0)
+  {
+    value = (value + (value < 0 ? -5 : 5)) / 10;
+    decimals--;
+  }
+}
+void SegmentControllerBase::setFixed(long value, byte scale)
+{
+  formatFixed(value, scale);
 }
-*/
 
-void SegmentController::setString(String text, int shift) 
+void SegmentControllerBase::setString(const String& text, int shift) 
 {
   if (isStringEmpty(text))
     return;
-  disableScroller();
+  showText(text.c_str(), false, text.length(), shift);
+}
+void SegmentControllerBase::setString(const char* text, int shift)
+{
+  if (text == NULL || text[0] == '\0')
+    return;
+  showText(text, false, strlen(text), shift);
+}
+void SegmentControllerBase::setString(const __FlashStringHelper* text, int shift)
+{
+  PGM_P p = reinterpret_cast<PGM_P>(text);
+  if (p == NULL || pgm_read_byte(p) == '\0')
+    return;
+  showText(p, true, strlen_P(p), shift);
+}
 
-  for (int i = _displayLength - 1; i >= 0 ; i--)
+size_t SegmentControllerBase::write(uint8_t character)
+{
+  if (character == '\r')
+    return 1;
+  if (character == '\n')
   {
-    int index = (_displayLength - 1) - i;
-    index += shift;
+    _printNewLine = true;
+    _printOverflow = false;
+    return 1;
+  }
 
-    if (index < 0 || index >= text.length())
-      _displayedBytes[i] = _digits[10];
-    else 
-      _displayedBytes[i] = getCharacter(text[index]);
+  if (_printNewLine)
+  {
+    clear();
+    _printNewLine = false;
   }
+  // the rest of a line that didn't fit is taken and dropped, so a '\n' in the same buffer still gets here
+  if (_printOverflow)
+    return 1;
+  stopAnimations();
+
+  // a dot goes onto the digit before, unless it has one already
+  if (character == '.' && _printCursor > 0 && _printCursor <= _displayLength && !digitSegmentActive(_printCursor - 1, 7))
+  {
+    setDigitSegment(_printCursor - 1, 7, true);
+    return 1;
+  }
+
+  // no space left: a cut off line could be read as another value, every digit shows a minus instead
+  if (_printCursor >= _displayLength)
+  {
+    for (int i = 0; i < _displayLength; i++)
+      setDigit(i, getMinus());
+    _printOverflow = true;
+    return 1;
+  }
+  setDigit(_printCursor++, getCharacter(character));
+  return 1;
+}
+size_t SegmentControllerBase::printf(const char* format, ...)
+{
+  // enough for every digit with a dot
+  char buffer[MAXDIGITS * 2 + 1];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  // a cut off text keeps its line end, the next line starts over
+  size_t formatLength = strlen(format);
+  if (length >= (int)sizeof(buffer) && formatLength > 0 && format[formatLength - 1] == '\n')
+    buffer[sizeof(buffer) - 2] = '\n';
+  return write(buffer);
+}
+void SegmentControllerBase::setCursor(byte digitIndex)
+{
+  _printCursor = digitIndex;
+  _printNewLine = false;
+  _printOverflow = false;
+}
+byte SegmentControllerBase::getCursor()
+{
+  return _printCursor;
 }
 
-void SegmentController::setDigit(byte digitIndex, byte b) 
+void SegmentControllerBase::setDigit(byte digitIndex, byte b) 
 {
   if (!isDigitInRange(digitIndex))
     return;
-  _displayedBytes[_displayLength - digitIndex- 1] = b;
+  _digitStates[_displayLength - digitIndex- 1].content = b;
+  _frameDirty = true;
 }
-byte SegmentController::getDigit(byte digitIndex)
+byte SegmentControllerBase::getDigit(byte digitIndex)
 {
   if (!isDigitInRange(digitIndex))
     return 0;
-  return _displayedBytes[_displayLength - digitIndex - 1];
+  return _digitStates[_displayLength - digitIndex - 1].content;
 }
-void SegmentController::setDigitSegment(byte digitIndex, byte segmentIndex, bool value)
+void SegmentControllerBase::setDigitSegment(byte digitIndex, byte segmentIndex, bool value)
 {
   if (!isDigitInRange(digitIndex) || !isSegmentInRange(segmentIndex))
     return;
-  _displayedBytes[_displayLength - digitIndex - 1] = setSegment(_displayedBytes[_displayLength - digitIndex - 1], segmentIndex, value);
+  _digitStates[_displayLength - digitIndex - 1].content = setSegment(_digitStates[_displayLength - digitIndex - 1].content, segmentIndex, value);
+  _frameDirty = true;
 }
-bool SegmentController::digitSegmentActive(byte digitIndex, byte segmentIndex)
+bool SegmentControllerBase::digitSegmentActive(byte digitIndex, byte segmentIndex)
 {
   if (!isDigitInRange(digitIndex) || !isSegmentInRange(segmentIndex))
     return false;
-  return isSegmentActive(_displayedBytes[_displayLength - digitIndex - 1], segmentIndex);
+  return isSegmentActive(_digitStates[_displayLength - digitIndex - 1].content, segmentIndex);
+}
+
+void SegmentControllerBase::setOverlay(byte digitIndex, byte b)
+{
+  if (!isDigitInRange(digitIndex))
+    return;
+  setLayer(_digitStates[_displayLength - digitIndex - 1].overlay, b);
+}
+byte SegmentControllerBase::getOverlay(byte digitIndex)
+{
+  if (!isDigitInRange(digitIndex))
+    return 0;
+  return _digitStates[_displayLength - digitIndex - 1].overlay;
+}
+void SegmentControllerBase::setOverlaySegment(byte digitIndex, byte segmentIndex, bool value)
+{
+  if (!isDigitInRange(digitIndex) || !isSegmentInRange(segmentIndex))
+    return;
+  byte& overlay = _digitStates[_displayLength - digitIndex - 1].overlay;
+  setLayer(overlay, setSegment(overlay, segmentIndex, value));
+}
+void SegmentControllerBase::clearOverlay()
+{
+  for (int i = 0; i < _displayLength; i++)
+    setLayer(_digitStates[i].overlay, 0);
+}
+void SegmentControllerBase::setMask(byte digitIndex, byte b)
+{
+  if (!isDigitInRange(digitIndex))
+    return;
+  setLayer(_digitStates[_displayLength - digitIndex - 1].mask, b);
+}
+byte SegmentControllerBase::getMask(byte digitIndex)
+{
+  if (!isDigitInRange(digitIndex))
+    return 0;
+  return _digitStates[_displayLength - digitIndex - 1].mask;
+}
+void SegmentControllerBase::setMaskSegment(byte digitIndex, byte segmentIndex, bool value)
+{
+  if (!isDigitInRange(digitIndex) || !isSegmentInRange(segmentIndex))
+    return;
+  byte& mask = _digitStates[_displayLength - digitIndex - 1].mask;
+  setLayer(mask, setSegment(mask, segmentIndex, value));
+}
+void SegmentControllerBase::clearMask()
+{
+  for (int i = 0; i < _displayLength; i++)
+    setLayer(_digitStates[i].mask, 0);
 }
 
 
 /*-- SCROLLER --*/
 
-void SegmentController::setScroller(String text)
+void SegmentControllerBase::setScroller(const String& text)
 {
   if (isStringEmpty(text))
     return;
-  clear();
-
-  _isScrolling = true;
-  _scrollerLength = text.length();
-  if(_scrollerLength > MAXSCROLLERSIZE)
-    _scrollerLength = MAXSCROLLERSIZE;
-  
-  _currentScrollIndex = -1;
-  _previousScrollTime = millis();
+  setScroller(text.c_str());
+}
+void SegmentControllerBase::setScroller(const char* text)
+{
+  if (text == NULL || text[0] == '\0')
+    return;
+  startScroller(SOURCE_NONE, 0);
+  appendScroller(text);
+}
+void SegmentControllerBase::setScrollerSource(const char* text)
+{
+  if (text == NULL || text[0] == '\0')
+    return;
+  startScroller(SOURCE_TEXT, strlen(text));
+  _sourceText = text;
+}
+void SegmentControllerBase::setScroller(const __FlashStringHelper* text)
+{
+  PGM_P p = reinterpret_cast<PGM_P>(text);
+  if (p == NULL || pgm_read_byte(p) == '\0')
+    return;
+  startScroller(SOURCE_FLASH, strlen_P(p));
+  _sourceText = p;
+}
+void SegmentControllerBase::setScroller(SegmentGenerator generator, unsigned int length)
+{
+  if (generator == NULL || length == 0)
+    return;
+  startScroller(SOURCE_GENERATOR, length);
+  _sourceGenerator = generator;
+}
+void SegmentControllerBase::setScroller(byte bytes[], int size)
+{
+  startScroller(SOURCE_NONE, 0);
+  appendScroller(bytes, size);
+}
+int SegmentControllerBase::appendScroller(const String& text)
+{
+  if (isStringEmpty(text))
+    return 0;
+  return appendScroller(text.c_str());
+}
+int SegmentControllerBase::appendScroller(const char* text)
+{
+  if (text == NULL || text[0] == '\0')
+    return 0;
+  if (!_isScrolling)
+    startScroller(SOURCE_NONE, 0);
+  if (!padScroller())
+    return 0;
 
-  for (int i = 0; i < _scrollerLength; i++)
-  {
-    _scroller[i] = getCharacter(text[i]);
-  }
+  int count = 0;
+  while (text[count] != '\0' && getScrollerSpace() > 0)
+    _scroller[(_ringStart + _ringLength++) % MAXSCROLLERSIZE] = getCharacter(text[count++]);
+  return count;
 }
-void SegmentController::setScroller(byte bytes[], int size)
+int SegmentControllerBase::appendScroller(byte bytes[], int size)
 {
-  clear();
-  _isScrolling = true;
-  _scrollerLength = size;
-  if(_scrollerLength > MAXSCROLLERSIZE)
-    _scrollerLength = MAXSCROLLERSIZE;
-  
-  _currentScrollIndex = -1;
-  _previousScrollTime = millis();
+  if (!_isScrolling)
+    startScroller(SOURCE_NONE, 0);
+  if (!padScroller())
+    return 0;
 
-  for (int i = 0; i < _scrollerLength; i++)
-  {
-    _scroller[i] = bytes[i];
-  }
+  int count = 0;
+  while (count < size && getScrollerSpace() > 0)
+    _scroller[(_ringStart + _ringLength++) % MAXSCROLLERSIZE] = bytes[count++];
+  return count;
 }
-void SegmentController::appendScroller(String text)
+unsigned int SegmentControllerBase::getScrollerSpace()
 {
-  if (isStringEmpty(text))
+  return MAXSCROLLERSIZE - _ringLength;
+}
+void SegmentControllerBase::setScrollerLoop(bool value)
+{
+  _scrollerLoop = value;
+}
+bool SegmentControllerBase::getScrollerLoop()
+{
+  return _scrollerLoop;
+}
+
+void SegmentControllerBase::setScrollElement(unsigned int index, byte b)
+{
+  if (index >= getScrollerLength())
     return;
-  if (!_isScrolling)
-  {
-    setScroller(text);
+  // the text the scroller reads from has to be copied first (only if it fits)
+  if (index < _sourceLength && !copyScrollerSource())
     return;
-  }
-
-  int l = text.length();
-  _scrollerLength += l;
+  _scroller[(_ringStart + index - _sourceLength) % MAXSCROLLERSIZE] = b;
+  if (_isScrolling)
+    showScroller();
+}
+byte SegmentControllerBase::getScrollElement(unsigned int index)
+{
+  if (index >= getScrollerLength())
+    return 0;
 
-  _previousScrollTime = millis();
+  // the text (read when needed) comes first, the appended bytes follow in the ring buffer
+  if (index >= _sourceLength)
+    return _scroller[(_ringStart + index - _sourceLength) % MAXSCROLLERSIZE];
 
-  for (int i = _scrollerLength - l; i < _scrollerLength; i++)
+  index += _sourceStart;
+  switch (_sourceType)
   {
-    if (i > MAXSCROLLERSIZE)
-    {
-      _scrollerLength = MAXSCROLLERSIZE;
-      return;
-    }
-      
-    _scroller[i] = getCharacter(text[i - _scrollerLength + l]);
+    case SOURCE_TEXT:
+      return getCharacter(_sourceText[index]);
+    case SOURCE_FLASH:
+      return getCharacter(pgm_read_byte(&_sourceText[index]));
+    case SOURCE_GENERATOR:
+      return _sourceGenerator(index);
   }
+  return pgm_read_byte(&_digits[10]);
+}
+unsigned int SegmentControllerBase::getScrollerLength()
+{
+  return _sourceLength + _ringLength;
+}
+void SegmentControllerBase::setScrollerUpdateTime(unsigned int updateTime)
+{
+  _scrollUpdateTime = updateTime;
+}
+unsigned int SegmentControllerBase::getScrollerUpdateTime()
+{
+  return _scrollUpdateTime;
+}
+
+
+/*-- TIMELINE --*/
+
+void SegmentControllerBase::playTimeline(const SegmentFrame* frames, byte count, bool loop)
+{
+  if (frames == NULL || count == 0)
+    return;
+  stopAnimations();
+
+  _timeline = frames;
+  _timelineLength = count;
+  _timelineLoop = loop;
+  _timelinePlaying = true;
+  _timelineFrame = 0;
+  _timelineStart = millis();
+  showTimelineFrame();
 }
-void SegmentController::appendScroller(byte bytes[], int size)
+void SegmentControllerBase::stopTimeline()
 {
-  if (!_isScrolling)
-  {
-    setScroller(bytes, size);
+  if (!_timelinePlaying)
     return;
-  }
-
-  _scrollerLength += size;
-  _previousScrollTime = millis();
-
-  for (int i = _scrollerLength - size; i < _scrollerLength; i++)
-  {
-    if (i > MAXSCROLLERSIZE)
-    {
-      _scrollerLength = MAXSCROLLERSIZE;
-      return;
-    }
-      
-    _scroller[i] = bytes[i - _scrollerLength + size];
-  }
+  _timelinePlaying = false;
+  setTimelineEffects(0);
+}
+bool SegmentControllerBase::isTimelinePlaying()
+{
+  return _timelinePlaying;
+}
+byte SegmentControllerBase::getTimelineFrame()
+{
+  return _timelineFrame;
 }
 
-void SegmentController::setScrollElement(byte index, byte b)
+void SegmentControllerBase::bindValue(const volatile long* value, byte scale, unsigned int sampleTime)
 {
-  if (index < 0 && index >= _scrollerLength)
+  if (value == NULL)
     return;
-  _scroller[index] = b;
+  _bindValue = value;
+  bind(BIND_LONG, scale, sampleTime);
 }
-byte SegmentController::getScrollElement(byte index)
+void SegmentControllerBase::bindValue(const volatile int* value, byte scale, unsigned int sampleTime)
 {
-  if (index < 0 && index >= _scrollerLength)
-    return 0;
-  return _scroller[index];
+  if (value == NULL)
+    return;
+  _bindValue = value;
+  bind(BIND_INT, scale, sampleTime);
 }
-byte SegmentController::getScrollerLength()
+void SegmentControllerBase::bindValue(SegmentValueSource source, byte scale, unsigned int sampleTime)
 {
-  return _scrollerLength;
+  if (source == NULL)
+    return;
+  _bindSource = source;
+  bind(BIND_SOURCE, scale, sampleTime);
 }
-void SegmentController::setScrollerUpdateTime(unsigned int updateTime)
+void SegmentControllerBase::unbindValue()
 {
-  _scrollUpdateTime = updateTime;
+  _bindType = BIND_NONE;
 }
-unsigned int SegmentController::getScrollerUpdateTime()
+bool SegmentControllerBase::isValueBound()
 {
-  return _scrollUpdateTime;
+  return _bindType != BIND_NONE;
+}
+void SegmentControllerBase::setValueHysteresis(unsigned long hysteresis)
+{
+  _bindHysteresis = hysteresis;
+}
+void SegmentControllerBase::setValueAveraging(byte samples)
+{
+  // the sum of the average (up to 10^digits times the samples) has to fit into a long, 32 bit on an AVR
+  unsigned long maxSamples = 2147483647UL / getNumberLimit();
+  if (samples > maxSamples)
+    samples = maxSamples;
+  _bindAveraging = samples > 0 ? samples : 1;
+  // the average starts at the shown value
+  _bindSum = _bindShown * _bindAveraging;
 }
 
 
 /*-- GET --*/
 
-byte SegmentController::getNumber(int number)
+byte SegmentControllerBase::getNumber(int number)
 {
   if (number < 0 || number > 9)
-    return _digits[10];
-  return _digits[number];
+    return pgm_read_byte(&_digits[10]);
+  return pgm_read_byte(&_digits[number]);
 }
-byte SegmentController::getCharacter(char character)
+byte SegmentControllerBase::getCharacter(char character)
 {
   character = tolower(character);
 
   if (isAlpha(character))
-    return _alphabet[(character - 97)];
+    return pgm_read_byte(&_alphabet[(character - 97)]);
   if (isDigit(character))
-    return _digits[(character - 48)];
+    return pgm_read_byte(&_digits[(character - 48)]);
 
   switch (character)
   {
@@ -396,64 +887,64 @@ byte SegmentController::getCharacter(char character)
     case '\'':
       return getSegment(5);
     case ',':
-      return _specialCharacters[0];
+      return pgm_read_byte(&_specialCharacters[0]);
     case '!':
-      return _specialCharacters[1];
+      return pgm_read_byte(&_specialCharacters[1]);
     case '?':
-      return _specialCharacters[2];
+      return pgm_read_byte(&_specialCharacters[2]);
     case '=':
-      return _specialCharacters[3];
+      return pgm_read_byte(&_specialCharacters[3]);
     case '>':
-      return _specialCharacters[4];
+      return pgm_read_byte(&_specialCharacters[4]);
     case '<':
-      return _specialCharacters[5];
+      return pgm_read_byte(&_specialCharacters[5]);
     case '(':
-      return _specialCharacters[6];
+      return pgm_read_byte(&_specialCharacters[6]);
     case ')':
-      return _specialCharacters[7];
+      return pgm_read_byte(&_specialCharacters[7]);
     case '/':
-      return _specialCharacters[8];
+      return pgm_read_byte(&_specialCharacters[8]);
     case '\\':
-      return _specialCharacters[9];
+      return pgm_read_byte(&_specialCharacters[9]);
     case '*':
-      return _specialCharacters[10];
+      return pgm_read_byte(&_specialCharacters[10]);
     case '°':
-      return _specialCharacters[10];
+      return pgm_read_byte(&_specialCharacters[10]);
     case '"':
-      return _specialCharacters[11];
+      return pgm_read_byte(&_specialCharacters[11]);
     case '^':
-      return _specialCharacters[12];
+      return pgm_read_byte(&_specialCharacters[12]);
   }
 
-  return _digits[10];
+  return pgm_read_byte(&_digits[10]);
 }
-byte SegmentController::getMinus()
+byte SegmentControllerBase::getMinus()
 {
   return getSegment(6);
 }
-byte SegmentController::getDot()
+byte SegmentControllerBase::getDot()
 {
   return getSegment(7);
 }
-byte SegmentController::getSegment(byte segmentIndex)
+byte SegmentControllerBase::getSegment(byte segmentIndex)
 {
   if (!isSegmentInRange(segmentIndex))
     return 0;
-  return round(pow(2, segmentIndex));
+  return 1 << segmentIndex;
 }
 
 
 /*-- BYTES --*/
 
-byte SegmentController::combineBytes(byte byte1, byte byte2)
+byte SegmentControllerBase::combineBytes(byte byte1, byte byte2)
 {
   return byte1 | byte2;
 }
-byte SegmentController::subtractBytes(byte byte1, byte subtraction)
+byte SegmentControllerBase::subtractBytes(byte byte1, byte subtraction)
 {
   return byte1 & (~subtraction);
 }
-byte SegmentController::setSegment(byte byte1, byte segmentIndex, bool value)
+byte SegmentControllerBase::setSegment(byte byte1, byte segmentIndex, bool value)
 {
   if (!isSegmentInRange(segmentIndex))
     return byte1;
@@ -462,7 +953,7 @@ byte SegmentController::setSegment(byte byte1, byte segmentIndex, bool value)
     return combineBytes(byte1, getSegment(segmentIndex));
   return subtractBytes(byte1, getSegment(segmentIndex));
 }
-bool SegmentController::isSegmentActive(byte byte1, byte segmentIndex)
+bool SegmentControllerBase::isSegmentActive(byte byte1, byte segmentIndex)
 {
   if (!isSegmentInRange(segmentIndex))
     return false;
@@ -473,76 +964,123 @@ bool SegmentController::isSegmentActive(byte byte1, byte segmentIndex)
 
 /*-- EFFECTS --*/
 
-void SegmentController::setDigitState(byte digitIndex, bool value)
+void SegmentControllerBase::setDigitState(byte digitIndex, bool value)
 {
-  if (!isDigitInRange(digitIndex))
-    return;
-  _digitEnabled[digitIndex] = value;
+  setEffect(_enabledDigits, digitIndex, value);
 }
-void SegmentController::setDigitStateAll(bool value)
+void SegmentControllerBase::setDigitStateAll(bool value)
 {
-  for (int i = 0; i < _displayLength; i++)
-    _digitEnabled[i] = value;
+  _enabledDigits = value ? (SEGMENT_MASK_TYPE)~0 : 0;
 }
-bool SegmentController::getDigitState(byte digitIndex)
+bool SegmentControllerBase::getDigitState(byte digitIndex)
 {
-  if (!isDigitInRange(digitIndex))
-    return false;
-  return _digitEnabled[digitIndex];
+  return getEffect(_enabledDigits, digitIndex);
 }
 
-void SegmentController::setBlinking(byte digitIndex, bool value)
+void SegmentControllerBase::setBlinking(byte digitIndex, bool value)
 {
-  if (!isDigitInRange(digitIndex))
-    return;
-  _digitBlinking[digitIndex] = value;
+  setEffect(_blinkingDigits, digitIndex, value);
 }
-void SegmentController::setBlinkingAll(bool value)
+void SegmentControllerBase::setBlinkingAll(bool value)
 {
-  for (int i = 0; i < _displayLength; i++)
-    _digitBlinking[i] = value;
+  _blinkingDigits = value ? (SEGMENT_MASK_TYPE)~0 : 0;
 }
-bool SegmentController::getBlinking(byte digitIndex)
+bool SegmentControllerBase::getBlinking(byte digitIndex)
 {
-  if (!isDigitInRange(digitIndex))
-    return false;
-  return _digitBlinking[digitIndex];
+  return getEffect(_blinkingDigits, digitIndex);
+}
+
+void SegmentControllerBase::setInverted(byte digitIndex, bool value)
+{
+  setEffect(_invertedDigits, digitIndex, value);
+  _frameDirty = true;
+}
+void SegmentControllerBase::setInvertedAll(bool value)
+{
+  _invertedDigits = value ? (SEGMENT_MASK_TYPE)~0 : 0;
+  _frameDirty = true;
+}
+bool SegmentControllerBase::getInverted(byte digitIndex)
+{
+  return getEffect(_invertedDigits, digitIndex);
+}
+
+void SegmentControllerBase::setFading(byte digitIndex, bool value)
+{
+  setEffect(_fadingDigits, digitIndex, value);
+}
+void SegmentControllerBase::setFadingAll(bool value)
+{
+  _fadingDigits = value ? (SEGMENT_MASK_TYPE)~0 : 0;
+}
+bool SegmentControllerBase::getFading(byte digitIndex)
+{
+  return getEffect(_fadingDigits, digitIndex);
+}
+
+void SegmentControllerBase::setChasing(byte digitIndex, bool value)
+{
+  setEffect(_chasingDigits, digitIndex, value);
+}
+void SegmentControllerBase::setChasingAll(bool value)
+{
+  _chasingDigits = value ? (SEGMENT_MASK_TYPE)~0 : 0;
+}
+bool SegmentControllerBase::getChasing(byte digitIndex)
+{
+  return getEffect(_chasingDigits, digitIndex);
 }
 
-void SegmentController::setBlinkInterval(unsigned int blinkInterval)
+void SegmentControllerBase::setBlinkInterval(unsigned int blinkInterval)
 {
   _blinkInterval = blinkInterval;
 }
-unsigned int SegmentController::getBlinkInterval()
+unsigned int SegmentControllerBase::getBlinkInterval()
 {
   return _blinkInterval;
 }
 
-void SegmentController::resetEffects()
+void SegmentControllerBase::resetEffects()
 {
   setDigitStateAll(true);
   setBlinkingAll(false);
+  setInvertedAll(false);
+  setFadingAll(false);
+  setChasingAll(false);
 }
 
 
 /*-- CHECKS --*/
 
-bool SegmentController::isNumberInRange(int number)
+bool SegmentControllerBase::isNumberInRange(int number)
+{
+  return isNumberInRange((long)number);
+}
+bool SegmentControllerBase::isNumberInRange(long number)
 {
-  return (-(pow(10, _displayLength - 1) - 1)) <= number && number <= (pow(10, _displayLength) - 1);
+  // negative numbers need one digit for the minus
+  unsigned long limit = getNumberLimit();
+  if (number < 0)
+    return 0UL - (unsigned long)number < limit / 10;
+  return (unsigned long)number < limit;
 }
-bool SegmentController::isNumberInRange(float number)
+bool SegmentControllerBase::isNumberInRange(float number)
 {
-  return (-(pow(10, _displayLength - 1) - 1)) <= number && number <= (pow(10, _displayLength) - 1);
+  unsigned long limit = getNumberLimit();
+  return -(float)(limit / 10 - 1) <= number && number <= (float)(limit - 1);
 }
-bool SegmentController::isDigitInRange(byte digitIndex) 
+bool SegmentControllerBase::isDigitInRange(byte digitIndex) 
 {
   return 0 <= digitIndex && digitIndex < _displayLength;
 }
-bool SegmentController::isSegmentInRange(byte segmentIndex)
+bool SegmentControllerBase::isSegmentInRange(byte segmentIndex)
 {
   return 0 <= segmentIndex && segmentIndex < 8;
 }
+byte SegmentControllerBase::getDisplayLength()
+{
+  return _displayLength;
+}
 
 
 
@@ -550,63 +1088,622 @@ bool SegmentController::isSegmentInRange(byte segmentIndex)
   --- PRIVATE METHODS ---
 */
 
-void SegmentController::setSegments(byte d)
+void SegmentControllerBase::showDigit(byte index)
+{
+  _driver->showDigit(index, _digitStates[index].frames[_frontFrame]);
+}
+void SegmentControllerBase::hideDigit(byte index)
+{
+  _driver->hideDigit(index);
+}
+void SegmentControllerBase::update()
+{
+  if (_isScrolling)
+    updateScroller();
+  if (_timelinePlaying)
+    updateTimeline();
+  if (_bindType != BIND_NONE && millis() - _previousBindTime >= _bindSampleTime)
+    updateBinding();
+
+  // self-scanning hardware only gets the visible bytes
+  if (_driver->isSelfScanning())
+    pushFrame();
+  else
+    publishFrame();
+}
+void SegmentControllerBase::pushFrame()
+{
+  updateEffects();
+  byte bytes[MAXDIGITS];
+  for (int i = 0; i < _displayLength; i++)
+    bytes[i] = isDigitVisible(i) ? getFrameByte(i) : pgm_read_byte(&_digits[10]);
+  _driver->writeFrame(bytes, _displayLength);
+}
+bool SegmentControllerBase::isDigitVisible(byte index)
+{
+  return (_visibleDigits >> index) & 1;
+}
+byte SegmentControllerBase::getFrameByte(byte index)
+{
+  // the layers are combined only when a frame is published, inverted digits swap their segments afterwards (the dp stays)
+  byte b = (_digitStates[index].content & ~_digitStates[index].mask) | _digitStates[index].overlay;
+  if ((_invertedDigits >> index) & 1)
+    b ^= 0b01111111;
+  return b;
+}
+void SegmentControllerBase::nextSlot()
+{
+  if (_segmentScan)
+  {
+    // every segment gets a slot, no matter how many digits there are
+    _scanSlot = _scanSlot + 1 >= _driver->getSegmentCount() ? 0 : _scanSlot + 1;
+    if (_scanSlot == 0)
+      startFrame();
+
+    // the digits using the segment in the front frame
+    SEGMENT_MASK_TYPE digits = 0;
+    for (int i = 0; i < _displayLength; i++)
+      if ((_digitStates[i].bytes[_frontFrame] >> _scanSlot) & 1)
+        digits |= (SEGMENT_MASK_TYPE)1 << i;
+    _slotDimmed = (digits & _dimmedDigits) != 0;
+    _slotBits = digits & _visibleDigits;
+    byte lit = countBits(_slotBits);
+    _slotParts = _segmentLimit > 0 && lit > _segmentLimit ? (lit + _segmentLimit - 1) / _segmentLimit : 1;
+    return;
+  }
+
+  // disabled digits don't get a slot, the last slot (_displayLength) stays dark
+  byte previous = _scanSlot;
+  do
+    _scanSlot = _scanSlot >= _displayLength ? 0 : _scanSlot + 1;
+  while (_scanSlot < _displayLength && !((_enabledDigits >> _scanSlot) & 1));
+
+  // a new frame only starts when the scan starts over (also if the first digits are disabled), so a frame is never shown half old/half new
+  if (_scanSlot <= previous)
+    startFrame();
+
+  _slotDimmed = _scanSlot < _displayLength && ((_dimmedDigits >> _scanSlot) & 1);
+  _slotBits = _scanSlot < _displayLength ? _digitStates[_scanSlot].bytes[_frontFrame] : 0;
+  byte lit = _scanSlot < _displayLength ? _digitStates[_scanSlot].lit : 0;
+  _slotParts = _segmentLimit > 0 && lit > _segmentLimit ? (lit + _segmentLimit - 1) / _segmentLimit : 1;
+}
+void SegmentControllerBase::resetScan()
+{
+  // the next scan() starts a new frame
+  _scanSlot = getSlotCount(_segmentScan) - 1;
+  _scanPlane = 0;
+  _scanPart = 0;
+  _slotParts = 1;
+}
+SEGMENT_MASK_TYPE SegmentControllerBase::getPart(SEGMENT_MASK_TYPE bits, byte part, byte limit)
+{
+  // the set bits from part * limit on (counted from bit 0), at most limit of them
+  SEGMENT_MASK_TYPE result = 0;
+  int skip = part * limit;
+  byte taken = 0;
+  for (; bits != 0 && taken < limit; bits &= bits - 1)
+  {
+    if (skip > 0)
+    {
+      skip--;
+      continue;
+    }
+    result |= bits & (SEGMENT_MASK_TYPE)~(bits - 1);
+    taken++;
+  }
+  return result;
+}
+byte SegmentControllerBase::countBits(SEGMENT_MASK_TYPE bits)
+{
+  byte count = 0;
+  for (; bits != 0; bits &= bits - 1)
+    count++;
+  return count;
+}
+void SegmentControllerBase::startFrame()
+{
+  unsigned long now = micros();
+  adaptSlotTime(now - _frameStart);
+  _frameStart = now;
+
+  swapFrame();
+  updateEffects();
+#ifdef SEGMENT_STATS
+  _statsFrames++;
+#endif
+}
+void SegmentControllerBase::adaptSlotTime(unsigned long frameTime)
+{
+  if (_frameRate == 0)
+    return;
+
+  // a single late frame (e.g. a long delay) only counts as twice the frame time
+  unsigned long targetTime = 1000000UL / _frameRate;
+  if (frameTime > targetTime * 2)
+    frameTime = targetTime * 2;
+
+  // the time the application spends between the slots is part of the frame: move half the difference onto every slot
+  byte slots = getSlotCount(_segmentScan);
+  long slotTime = (long)_slotTime + ((long)targetTime - (long)frameTime) / 2 / slots;
+
+  // the longest slot that still keeps minFrameRate
+  long maxTime = _minFrameRate > 0 ? 1000000L / _minFrameRate / slots : slotTime;
+  if (slotTime > maxTime)
+    slotTime = maxTime;
+  if (slotTime < SEGMENT_MIN_SLOT_TIME)
+    slotTime = SEGMENT_MIN_SLOT_TIME;
+  setSlotTime(slotTime);
+}
+void SegmentControllerBase::setSlotTime(unsigned long slotTime)
+{
+  _slotTime = slotTime;
+  _planeTime = slotTime / SEGMENT_BCM_LEVELS;
+}
+void SegmentControllerBase::updateEffects()
+{
+  // the clock is read once per frame: blink phase (off in the second half), fade level (down in the first half, up in the second one) and chase step
+  unsigned long interval = _blinkInterval > 0 ? _blinkInterval : 1;
+  unsigned long now = millis();
+  unsigned long phase = now % (interval * 2);
+  byte fadeLevel = (phase < interval ? interval - phase : phase - interval) * SEGMENT_BCM_LEVELS / interval;
+
+  SEGMENT_MASK_TYPE visible = _enabledDigits;
+  if (phase >= interval)
+    visible &= ~_blinkingDigits;
+
+  // chase: only the chasing digit of the current step stays, counted from the left
+  byte count = 0;
+  for (int i = 0; i < _displayLength; i++)
+    count += (_chasingDigits >> i) & 1;
+  if (count > 0)
+  {
+    byte step = (now / interval) % count;
+    SEGMENT_MASK_TYPE runner = 0;
+    for (int i = _displayLength - 1; i >= 0 && runner == 0; i--)
+      if (((_chasingDigits >> i) & 1) && step-- == 0)
+        runner = (SEGMENT_MASK_TYPE)1 << i;
+    visible &= ~_chasingDigits | runner;
+  }
+
+  // lit segments of the new front frame, the heaviest visible digit keeps its on-time when the digits are equalized
+  byte maxLit = 0;
+  for (int i = 0; i < _displayLength; i++)
+  {
+    byte lit = countBits(_digitStates[i].bytes[_frontFrame]);
+    _digitStates[i].lit = lit;
+    if (((visible >> i) & 1) && lit > maxLit)
+      maxLit = lit;
+  }
+  bool equalize = _segmentEqualization && !_segmentScan && maxLit > 0;
+
+  // brightness of the visible digits in bit planes (full brightness: lit in all of them)
+  _dimmedDigits = 0;
+  for (int p = 0; p < SEGMENT_BCM_BITS; p++)
+    _planeDigits[p] = 0;
+  for (int i = 0; i < _displayLength; i++)
+  {
+    SEGMENT_MASK_TYPE bit = (SEGMENT_MASK_TYPE)1 << i;
+    if (!(visible & bit))
+      continue;
+
+    byte level = _digitStates[i].level;
+    if (_fadingDigits & bit)
+      level = level * fadeLevel / SEGMENT_BCM_LEVELS;
+    // a digit with fewer lit segments gets more current through the shared resistor, so less on-time (rounded up, lit digits stay visible)
+    if (equalize)
+      level = (level * _digitStates[i].lit + maxLit - 1) / maxLit;
+    if (level == 0)
+    {
+      visible &= ~bit;
+      continue;
+    }
+    if (level < SEGMENT_BCM_LEVELS)
+      _dimmedDigits |= bit;
+    for (int p = 0; p < SEGMENT_BCM_BITS; p++)
+      if ((level >> p) & 1)
+        _planeDigits[p] |= bit;
+  }
+  _visibleDigits = visible;
+}
+void SegmentControllerBase::setLayer(byte& layer, byte b)
+{
+  // setting the same byte again (e.g. in every loop) doesn't publish a new frame
+  if (layer == b)
+    return;
+  layer = b;
+  _frameDirty = true;
+}
+void SegmentControllerBase::setEffect(SEGMENT_MASK_TYPE& mask, byte digitIndex, bool value)
 {
-  // start with the first bit (right)
-  byte pointer = 1;
-  for (int i = 0; i < getSegmentLength(); i++)
+  // digitIndex counts from the left-most digit, the masks from the right-most one
+  if (!isDigitInRange(digitIndex))
+    return;
+  SEGMENT_MASK_TYPE bit = (SEGMENT_MASK_TYPE)1 << (_displayLength - 1 - digitIndex);
+  if (value)
+    mask |= bit;
+  else
+    mask &= ~bit;
+}
+bool SegmentControllerBase::getEffect(SEGMENT_MASK_TYPE mask, byte digitIndex)
+{
+  if (!isDigitInRange(digitIndex))
+    return false;
+  return (mask >> (_displayLength - 1 - digitIndex)) & 1;
+}
+void SegmentControllerBase::hideSlot()
+{
+  if (!_slotLit)
+    return;
+  if (_segmentScan)
+    _driver->hideSegment(_scanSlot);
+  else
+    hideDigit(_scanSlot);
+  _slotLit = false;
+}
+byte SegmentControllerBase::getSlotCount(bool segmentScan)
+{
+  // the digit scan keeps one slot dark
+  if (segmentScan)
+    return _driver->getSegmentCount();
+  return _displayLength + 1;
+}
+void SegmentControllerBase::publishFrame()
+{
+  if (!_frameDirty)
+    return;
+  _frameDirty = false;
+
+  // the interrupt can't run while the pending frame is written
+  noInterrupts();
+  byte pending = 1 - _frontFrame;
+  for (int i = 0; i < _displayLength; i++)
   {
-    // enable/disable the segment pin
-    bool value = (d & pointer) != 0;
-    digitalWrite(_segmentPins[i], isCommonAnode() ? !value : value);
-    // move one bit to the left
-    pointer *= 2;
+    byte content = getFrameByte(i);
+    _digitStates[i].bytes[pending] = content;
+    _driver->translate(content, _digitStates[i].frames[pending]);
   }
+  _framePending = true;
+  interrupts();
+}
+void SegmentControllerBase::swapFrame()
+{
+  if (!_framePending)
+    return;
+
+  _frontFrame = 1 - _frontFrame;
+  _framePending = false;
 }
-void SegmentController::transformDigit(byte digitIndex, int shift)
+void SegmentControllerBase::transformDigit(byte digitIndex, int shift)
 {
   int index = digitIndex + shift;
 
   if (isDigitInRange(index))
-    _displayedBytes[digitIndex] = _displayedBytes[index];
+    _digitStates[digitIndex].content = _digitStates[index].content;
   else
-    _displayedBytes[digitIndex] = _digits[10];
+    _digitStates[digitIndex].content = pgm_read_byte(&_digits[10]);
 }
 
-int SegmentController::getSegmentLength()
+byte SegmentControllerBase::getLevel(byte brightness)
+{
+  if (brightness == 0)
+    return 0;
+
+  // perceived brightness to on-time, every brightness above 0 stays visible
+  byte level = pgm_read_byte(&_gamma[brightness >> 3]) >> (8 - SEGMENT_BCM_BITS);
+  return level == 0 ? 1 : level;
+}
+void SegmentControllerBase::wait(unsigned long time)
 {
-  if (_hasDP)
-    return 8;
-  return 7;
+  delay(time / 1000);
+  delayMicroseconds(time % 1000);
 }
-bool SegmentController::isCommonAnode()
+
+void SegmentControllerBase::showText(const char* text, bool flash, unsigned int length, int shift)
 {
-  return _commonPinType == 1;
+  stopAnimations();
+
+  for (int i = _displayLength - 1; i >= 0 ; i--)
+  {
+    int index = (_displayLength - 1) - i;
+    index += shift;
+
+    if (index < 0 || index >= (int)length)
+      _digitStates[i].content = pgm_read_byte(&_digits[10]);
+    else 
+      _digitStates[i].content = getCharacter(flash ? pgm_read_byte(&text[index]) : text[index]);
+  }
+  _frameDirty = true;
 }
-bool SegmentController::isStringEmpty(String s)
+bool SegmentControllerBase::isStringEmpty(const String& s)
 {
   return s.length() <= 0;
 }
 
-void SegmentController::updateScroller()
+bool SegmentControllerBase::formatNumber(unsigned long number, bool negative, byte base, byte minDigits, bool alignLeft)
+{
+  if (base < 2 || base > 16)
+    return false;
+
+  // collect the digits from the right, nothing changes if the number doesn't fit
+  byte glyphs[MAXDIGITS];
+  byte count = 0;
+  do
+  {
+    if (count == _displayLength)
+      return false;
+    byte digit = number % base;
+    number /= base;
+    glyphs[count++] = digit < 10 ? pgm_read_byte(&_digits[digit]) : pgm_read_byte(&_alphabet[digit - 10]);
+  }
+  while (number > 0);
+
+  while (count < minDigits && count < _displayLength)
+    glyphs[count++] = pgm_read_byte(&_digits[0]);
+
+  if (negative)
+  {
+    if (count == _displayLength)
+      return false;
+    glyphs[count++] = getMinus();
+  }
+
+  stopAnimations();
+
+  // the right-most digit is at index 0, left aligned numbers start at the last index
+  byte offset = alignLeft ? _displayLength - count : 0;
+  for (int i = 0; i < _displayLength; i++)
+  {
+    if (i < offset || i >= offset + count)
+      _digitStates[i].content = pgm_read_byte(&_digits[10]);
+    else
+      _digitStates[i].content = glyphs[i - offset];
+  }
+  _frameDirty = true;
+  return true;
+}
+bool SegmentControllerBase::formatFixed(long value, byte scale)
+{
+  if (scale >= _displayLength)
+    return false;
+
+  // at least one digit in front of the dot: 5 with scale 2 -> 0.05
+  bool negativ = value < 0;
+  if (!formatNumber(negativ ? 0UL - (unsigned long)value : (unsigned long)value, negativ, DEC, scale + 1, false))
+    return false;
+
+  if (scale > 0)
+    setDigitSegment(_displayLength - 1 - scale, 7, true);
+  return true;
+}
+unsigned long SegmentControllerBase::getNumberLimit()
+{
+  // 10^_displayLength
+  unsigned long limit = 1;
+  for (int i = 0; i < _displayLength; i++)
+    limit *= 10;
+  return limit;
+}
+
+void SegmentControllerBase::startScroller(byte sourceType, unsigned int sourceLength)
+{
+  clear();
+
+  _isScrolling = true;
+  _sourceType = sourceType;
+  _sourceStart = 0;
+  _sourceLength = sourceLength;
+  _ringStart = 0;
+  _ringLength = 0;
+  _scrollPosition = -1;
+  _previousScrollTime = millis();
+}
+bool SegmentControllerBase::copyScrollerSource()
+{
+  if (_sourceLength > getScrollerSpace())
+    return false;
+
+  // put what's left of the text in front of the appended bytes
+  unsigned int start = (_ringStart + MAXSCROLLERSIZE - _sourceLength) % MAXSCROLLERSIZE;
+  for (unsigned int i = 0; i < _sourceLength; i++)
+    _scroller[(start + i) % MAXSCROLLERSIZE] = getScrollElement(i);
+
+  _ringStart = start;
+  _ringLength += _sourceLength;
+  _sourceType = SOURCE_NONE;
+  _sourceLength = 0;
+  return true;
+}
+bool SegmentControllerBase::padScroller()
+{
+  // the end of the text already entered the display: fill the gap with blanks, so appended bytes enter on the right
+  while (_scrollPosition >= (int)getScrollerLength() && getScrollerSpace() > 0)
+    _scroller[(_ringStart + _ringLength++) % MAXSCROLLERSIZE] = pgm_read_byte(&_digits[10]);
+  return _scrollPosition < (int)getScrollerLength();
+}
+void SegmentControllerBase::updateScroller()
+{
+  unsigned long elapsed = millis() - _previousScrollTime;
+  if (elapsed <= _scrollUpdateTime)
+    return;
+  _previousScrollTime = millis();
+#ifdef SEGMENT_STATS
+  // one step per update, the scroller slows down if update() comes too late
+  if (_scrollUpdateTime > 0)
+    _statsDroppedScrollSteps += elapsed / (_scrollUpdateTime + 1) - 1;
+#endif
+
+  // a stream without new bytes waits with an empty display
+  if (!_scrollerLoop && getScrollerLength() == 0)
+  {
+    _scrollPosition = -1;
+    return;
+  }
+
+  // the text left the display, start over
+  if (_scrollPosition - (_displayLength - 1) >= (int)getScrollerLength())
+    _scrollPosition = -1;
+  else
+  {
+    // move the view, nothing is copied
+    _scrollPosition++;
+
+    // a stream drops the element that just left the display (first from the text, then from the ring buffer)
+    if (!_scrollerLoop && _scrollPosition >= _displayLength)
+    {
+      if (_sourceLength > 0)
+      {
+        _sourceStart++;
+        _sourceLength--;
+      }
+      else
+      {
+        _ringStart = (_ringStart + 1) % MAXSCROLLERSIZE;
+        _ringLength--;
+      }
+      _scrollPosition--;
+    }
+  }
+  showScroller();
+}
+void SegmentControllerBase::showScroller()
+{
+  // the right-most digit shows the element at _scrollPosition, every digit to the left the one before
+  for (int i = 0; i < _displayLength; i++)
+  {
+    int index = _scrollPosition - i;
+    if (index < 0 || index >= (int)getScrollerLength())
+      _digitStates[i].content = pgm_read_byte(&_digits[10]);
+    else
+      _digitStates[i].content = getScrollElement(index);
+  }
+  _frameDirty = true;
+}
+void SegmentControllerBase::updateTimeline()
 {
-  if (millis() - _previousScrollTime > _scrollUpdateTime)
+  unsigned long duration = pgm_read_word(&_timeline[_timelineFrame].duration);
+  if (millis() - _timelineStart < duration)
+    return;
+
+  // the next frame starts when the last one is over, not when update() was called (no drift), frames that are over already are skipped
+  do
   {
-    transform(-1);
-    _currentScrollIndex++;
+    _timelineStart += duration;
+    _timelineFrame++;
+    if (_timelineFrame >= _timelineLength)
+    {
+      // the last frame stays (also if it was skipped)
+      if (!_timelineLoop)
+      {
+        _timelineFrame = _timelineLength - 1;
+        showTimelineFrame();
+        stopTimeline();
+        return;
+      }
+      _timelineFrame = 0;
+
+      // whole loops that are over already are skipped at once, a loop that is over in no time starts from now
+      unsigned long loopTime = 0;
+      for (int i = 0; i < _timelineLength; i++)
+        loopTime += pgm_read_word(&_timeline[i].duration);
+      if (loopTime == 0)
+      {
+        _timelineStart = millis();
+        break;
+      }
+      _timelineStart += (millis() - _timelineStart) / loopTime * loopTime;
+    }
+    duration = pgm_read_word(&_timeline[_timelineFrame].duration);
+  }
+  while (millis() - _timelineStart >= duration);
+
+  showTimelineFrame();
+}
+void SegmentControllerBase::showTimelineFrame()
+{
+  // the frame is only copied at its start
+  const SegmentFrame* frame = &_timeline[_timelineFrame];
+  for (int i = 0; i < _displayLength; i++)
+    _digitStates[i].content = pgm_read_byte(&frame->bytes[_displayLength - 1 - i]);
+  _frameDirty = true;
 
-    // reset the index if the text is done scrolling
-    if (_currentScrollIndex >= _scrollerLength + _displayLength)
-      _currentScrollIndex = -1;
+  setTimelineEffects(pgm_read_byte(&frame->effects));
+}
+void SegmentControllerBase::setTimelineEffects(byte effects)
+{
+  // only effects that changed, the brightness set by the user stays
+  byte changed = effects ^ _timelineEffects;
+  _timelineEffects = effects;
 
-    // set the next text element
-    else if (_currentScrollIndex < _scrollerLength)
-      _displayedBytes[0] = _scroller[_currentScrollIndex];
+  if (changed & FRAME_BLINK)
+    setBlinkingAll(effects & FRAME_BLINK);
+  if (changed & FRAME_DIM)
+    for (int i = 0; i < _displayLength; i++)
+      _digitStates[i].level = getLevel((effects & FRAME_DIM) ? _digitStates[i].brightness / 4 : _digitStates[i].brightness);
+}
+void SegmentControllerBase::bind(byte type, byte scale, unsigned int sampleTime)
+{
+  stopAnimations();
+  _bindType = type;
+  _bindScale = scale;
+  _bindSampleTime = sampleTime;
+  _bindSampled = false;
+  _bindShowing = false;
+  updateBinding();
+}
+long SegmentControllerBase::readBinding()
+{
+  if (_bindType == BIND_SOURCE)
+    return _bindSource();
+
+  // a variable written by an interrupt can't change while it is read
+  long value;
+  noInterrupts();
+  if (_bindType == BIND_LONG)
+    value = *(const volatile long*)_bindValue;
+  else
+    value = *(const volatile int*)_bindValue;
+  interrupts();
+  return value;
+}
+void SegmentControllerBase::updateBinding()
+{
+  _previousBindTime = millis();
+  long sample = readBinding();
+  // a sample beyond the display can't be shown anyway, clamped to its limit it can't overflow the sum of the average
+  long limit = (long)getNumberLimit();
+  if (sample > limit)
+    sample = limit;
+  else if (sample < -limit)
+    sample = -limit;
+
+  // exponential moving average: every sample replaces one average in the sum (weight 1/_bindAveraging)
+  if (_bindSampled)
+    _bindSum += sample - _bindSum / _bindAveraging;
+  else
+    _bindSum = sample * _bindAveraging;
+  _bindSampled = true;
+  long value = _bindSum / _bindAveraging;
 
-    _previousScrollTime = millis();
+  // nothing is written while the shown value stays (or stays inside the hysteresis)
+  if (_bindShowing)
+  {
+    unsigned long difference = value > _bindShown ? (unsigned long)(value - _bindShown) : (unsigned long)(_bindShown - value);
+    if (difference == 0 || difference <= _bindHysteresis)
+      return;
   }
+
+  // the set functions stop every animation, the binding included; a value that doesn't fit isn't shown, the hysteresis stays around the shown one
+  byte type = _bindType;
+  bool shown = formatFixed(value, _bindScale);
+  _bindType = type;
+  if (!shown)
+    return;
+  _bindShown = value;
+  _bindShowing = true;
 }
-void SegmentController::disableScroller()
+void SegmentControllerBase::stopAnimations()
 {
+  stopTimeline();
   _isScrolling = false;
+  _bindType = BIND_NONE;
 }
\ No newline at end of file
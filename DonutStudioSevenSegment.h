@@ -37,35 +37,231 @@
 #define MAXSCROLLERSIZE 64
 
 
+// refresh modes: wait for every digit inside refresh() / light at most one digit per refresh() call / scan() is called by a timer interrupt
+#define REFRESH_BLOCKING 0
+#define REFRESH_NONBLOCKING 1
+#define REFRESH_INTERRUPT 2
+
+// scan modes: one digit at a time (digits + 1 slots) / one segment on all digits at a time (7-8 slots) / whatever has fewer slots
+#define SCAN_DIGITS 0
+#define SCAN_SEGMENTS 1
+#define SCAN_AUTO 2
+
+// effects of a timeline frame: blink all digits / dim all digits to a quarter of the brightness
+#define FRAME_BLINK 1
+#define FRAME_DIM 2
+
+// software brightness: a dimmed slot is split into SEGMENT_BCM_BITS phases of 1, 2, 4, ... units (binary code modulation), 4 bits = 16 levels
+#ifndef SEGMENT_BCM_BITS
+#define SEGMENT_BCM_BITS 4
+#endif
+#define SEGMENT_BCM_LEVELS ((1 << SEGMENT_BCM_BITS) - 1)
+// shortest slot (in microseconds) the adaptive refresh timing goes down to
+#ifndef SEGMENT_MIN_SLOT_TIME
+#define SEGMENT_MIN_SLOT_TIME 200
+#endif
+
+
 #include "Arduino.h"
+#include "DonutStudioSegmentDrivers.h"
 
-class SegmentController
+static_assert(MAXDIGITS <= sizeof(SEGMENT_MASK_TYPE) * 8, "SEGMENT_MASK_TYPE needs a bit for every digit (MAXDIGITS)");
+
+// all digits from 0-9 and off
+#define SEGMENT_FONT_DIGITS 0b00111111, 0b00000110, 0b01011011, 0b01001111, 0b01100110, 0b01101101, 0b01111101, 0b00000111, 0b01111111, 0b01101111, 0b00000000
+// the alphabet
+#define SEGMENT_FONT_ALPHABET 0b01110111, 0b01111100, 0b01011000, 0b01011110, 0b01111001, 0b01110001, 0b00111101, 0b01110100, 0b00000100, 0b00011110, 0b01110101, 0b00111000, 0b01010101, 0b01010100, 0b01011100, 0b01110011, 0b01100111, 0b01010000, 0b00101101, 0b01111000, 0b00011100, 0b00101010, 0b01101010, 0b01110110, 0b01101110, 0b00011011
+// some special characters: , ! ? = > < ( ) / \ * " ^
+#define SEGMENT_FONT_SPECIAL_CHARACTERS 0b00001100, 0b10000010, 0b01010011, 0b01001000, 0b01001100, 0b01011000, 0b00111001, 0b00001111, 0b01010010, 0b01100100, 0b01100011, 0b00100010, 0b00100011
+
+// compile-time copy of the font, only read in constant expressions (the runtime font of SegmentController is in flash)
+namespace SegmentFont
 {
-  public:
-    SegmentController(bool commonAnode, int segmentPins[8], int digitPins[], byte displayLength, byte refreshTime);
+  constexpr byte digits[11] = { SEGMENT_FONT_DIGITS };
+  constexpr byte alphabet[26] = { SEGMENT_FONT_ALPHABET };
+  constexpr byte specialCharacters[13] = { SEGMENT_FONT_SPECIAL_CHARACTERS };
+
+  // the same byte as SegmentController::getCharacter, but evaluated by the compiler
+  constexpr byte character(char c)
+  {
+    return (c >= 'a' && c <= 'z') ? alphabet[c - 'a']
+      : (c >= 'A' && c <= 'Z') ? alphabet[c - 'A']
+      : (c >= '0' && c <= '9') ? digits[c - '0']
+      : c == '-' ? 0b01000000
+      : c == '.' ? 0b10000000
+      : c == '_' ? 0b00001000
+      : c == '\'' ? 0b00100000
+      : c == ',' ? specialCharacters[0]
+      : c == '!' ? specialCharacters[1]
+      : c == '?' ? specialCharacters[2]
+      : c == '=' ? specialCharacters[3]
+      : c == '>' ? specialCharacters[4]
+      : c == '<' ? specialCharacters[5]
+      : c == '(' ? specialCharacters[6]
+      : c == ')' ? specialCharacters[7]
+      : c == '/' ? specialCharacters[8]
+      : c == '\\' ? specialCharacters[9]
+      : c == '*' ? specialCharacters[10]
+      : c == '"' ? specialCharacters[11]
+      : c == '^' ? specialCharacters[12]
+      : digits[10];
+  }
+
+  template <size_t... I> struct Indices {};
+  template <size_t N, size_t... I> struct IndexBuilder : IndexBuilder<N - 1, N - 1, I...> {};
+  template <size_t... I> struct IndexBuilder<0, I...> { typedef Indices<I...> type; };
+}
+
+// function returning the byte of an element of a scroller (index from the start of the text)
+typedef byte (*SegmentGenerator)(unsigned int index);
+// function returning the value of a binding, e.g. a sensor reading
+typedef long (*SegmentValueSource)();
+
+// bytes of a text encoded at compile time, e.g. const SegmentText<4> hey PROGMEM = segmentText("Hey!");
+template <size_t N>
+struct SegmentText
+{
+  byte bytes[N];
+};
+
+template <size_t N, size_t... I>
+constexpr SegmentText<N - 1> segmentText(const char (&text)[N], SegmentFont::Indices<I...>)
+{
+  return SegmentText<N - 1>{ { SegmentFont::character(text[I])... } };
+}
+template <size_t N>
+constexpr SegmentText<N - 1> segmentText(const char (&text)[N])
+{
+  return segmentText(text, typename SegmentFont::IndexBuilder<N - 1>::type());
+}
+
+
+#ifdef SEGMENT_STATS
+// runtime counters of a controller since resetStats() (define SEGMENT_STATS for the library, e.g. in DonutStudioSegmentDrivers.h)
+struct SegmentStats
+{
+  // frames shown (the scan started over) and frames per second
+  unsigned long frames;
+  float frameRate;
+  // time (in microseconds) between two calls of scan(): longest and average
+  unsigned long maxScanGap;
+  unsigned long averageScanGap;
+  // non-blocking phases that were over before refresh() was called again
+  unsigned long missedDeadlines;
+  // time (in microseconds) spent in refresh(): all calls and the longest one
+  unsigned long refreshTime;
+  unsigned long maxRefreshTime;
+  // scroller steps left out because update()/refresh() came too late
+  unsigned long droppedScrollSteps;
+  // pins written by the driver and the writes it skipped
+  unsigned long pinWrites;
+  unsigned long skippedPinWrites;
+};
+#endif
+
+// one frame of a timeline kept in flash, e.g. const SegmentFrame boot[] PROGMEM = { { { 0x40, 0, 0, 0 }, 100, 0 }, ... };
+struct SegmentFrame
+{
+  // bytes of the digits (from the left-most digit on)
+  byte bytes[MAXDIGITS];
+  // time (in milliseconds) the frame is shown
+  uint16_t duration;
+  // FRAME_BLINK, FRAME_DIM
+  byte effects;
+};
+
+// all functions of the controller, the derived classes provide the digit storage
+class SegmentControllerBase : public Print
+{
+  friend class SegmentScheduler;
 
+  public:
     // refresh the display
     void refresh();
+    // set the refresh mode (REFRESH_BLOCKING, REFRESH_NONBLOCKING, REFRESH_INTERRUPT)
+    void setRefreshMode(byte mode);
+    // get the refresh mode
+    byte getRefreshMode();
+    // move the scan to the next digit and return the time (in microseconds) until the next call, safe to call from a timer interrupt:
+    // the timer has to be reloaded with this time, it changes between the phases (bit planes of dimmed digits, split slots, adapted frame rate)
+    unsigned long scan();
+    // set the scan mode (SCAN_DIGITS, SCAN_SEGMENTS, SCAN_AUTO), drivers without segment scan always scan digits
+    void setScanMode(byte mode);
+    // get the scan mode
+    byte getScanMode();
+    // check if the display is scanned segment by segment
+    bool isScanningSegments();
+    // hold a frame rate (frames per second) by adapting the time of a slot to the measured frames, a slot never gets so long that the display drops below minFrameRate (0: fixed refresh time)
+    void setFrameRate(unsigned int frameRate, unsigned int minFrameRate = 50);
+    // get the frame rate to hold (0: fixed refresh time)
+    unsigned int getFrameRate();
+    // get the time (in microseconds) of a slot
+    unsigned long getSlotTime();
+    // equalize digits with few and many lit segments (digit scan, one resistor per digit): the on-time of a digit follows its lit segments
+    void setSegmentEqualization(bool value);
+    // check if the digits are equalized
+    bool getSegmentEqualization();
+    // light at most maxSegments LEDs at once (0: no limit), a heavier slot is split into parts sharing its time (not in the SegmentScheduler)
+    void setSegmentLimit(byte maxSegments);
+    // get the most LEDs lit at once
+    byte getSegmentLimit();
+#ifdef SEGMENT_STATS
+    // get the runtime counters
+    SegmentStats getStats();
+    // start the runtime counters over
+    void resetStats();
+#endif
     // clear the display
     void clear();
     // move the display to the right (positive), or left (negative)
     void transform(int shift);
-    // set the brightness
+    // set the brightness of all digits (0-255, gamma corrected), works on every pin and scan mode
     void setBrightness(byte brightness);
     // get the brightness
     byte getBrightness();
+    // set the brightness of a digit
+    void setDigitBrightness(byte digitIndex, byte brightness);
+    // get the brightness of a digit
+    byte getDigitBrightness(byte digitIndex);
     
 
     // display custom symbols/bytes
     void setByte(byte b[]);
+    // display custom symbols/bytes stored in flash (PROGMEM), e.g. a SegmentText
+    void setByte_P(const byte b[]);
     // display a integer
-    void setInt(int number, bool showLeadZeros = false);
-
-    // display a float
-    //void setFloat(float number);
+    void setInt(long number, bool showLeadZeros = false);
+    // display an unsigned integer
+    void setUnsigned(unsigned long number, bool showLeadZeros = false);
+    // display an unsigned integer as hexadecimal
+    void setHex(unsigned long number, bool showLeadZeros = false);
+    // display an unsigned integer as binary
+    void setBinary(unsigned long number, bool showLeadZeros = false);
+    // display a integer in any base (2-16), aligned to the right (default) or left
+    void setNumber(long number, byte base = DEC, bool showLeadZeros = false, bool alignLeft = false);
+
+    // display a float with a number of decimals (reduced if the number doesn't fit)
+    void setFloat(float number, byte decimals = 2);
+    // display a fixed-point number: value / 10^scale, e.g. setFixed(1234, 2) shows 12.34
+    void setFixed(long value, byte scale);
 
     // display a string
-    void setString(String text, int shift = 0);
+    void setString(const String& text, int shift = 0);
+    // display a text without copying it into a String
+    void setString(const char* text, int shift = 0);
+    // display a text stored in flash, e.g. setString(F("Hey"))
+    void setString(const __FlashStringHelper* text, int shift = 0);
+
+    // print() writes from the left-most digit on, a '.' goes onto the digit before, the next print after a '\n' (println) starts over,
+    // a line too long for the display shows a minus on every digit (like a number that doesn't fit) until the next line, setCursor or clear
+    size_t write(uint8_t character);
+    using Print::write;
+    // formatted output (vsnprintf into a buffer on the stack, no String)
+    size_t printf(const char* format, ...);
+    // set the digit the next printed character goes to
+    void setCursor(byte digitIndex);
+    // get the digit the next printed character goes to
+    byte getCursor();
 
     // change a digit to a new byte
     void setDigit(byte digitIndex, byte b);
@@ -76,22 +272,79 @@ class SegmentController
     // check if a segment on a digit is enabled
     bool digitSegmentActive(byte digitIndex, byte segmentIndex);
 
-
-    // start a scoller with a text
-    void setScroller(String text);
+    // layers on top of the content, kept by every set function, clear() and the scroller: shown = (content & ~mask) | overlay
+    // set the overlay of a digit (segments always shown, e.g. a dp heartbeat or a unit)
+    void setOverlay(byte digitIndex, byte b);
+    // get the overlay of a digit
+    byte getOverlay(byte digitIndex);
+    // add/remove a segment of the overlay of a digit
+    void setOverlaySegment(byte digitIndex, byte segmentIndex, bool value);
+    // remove the overlay of all digits
+    void clearOverlay();
+    // set the mask of a digit (segments of the content never shown)
+    void setMask(byte digitIndex, byte b);
+    // get the mask of a digit
+    byte getMask(byte digitIndex);
+    // add/remove a segment of the mask of a digit
+    void setMaskSegment(byte digitIndex, byte segmentIndex, bool value);
+    // remove the mask of all digits
+    void clearMask();
+
+
+    // start a scoller with a text (copied, up to MAXSCROLLERSIZE characters)
+    void setScroller(const String& text);
+    // start a scoller with a text (copied, up to MAXSCROLLERSIZE characters)
+    void setScroller(const char* text);
+    // start a scoller with a text of any length, read while it scrolls (not copied: keep it alive and unchanged until the scroller stops)
+    void setScrollerSource(const char* text);
+    // start a scoller with a text of any length stored in flash, e.g. setScroller(F("Hey")) or setScroller((const __FlashStringHelper*)progmemText)
+    void setScroller(const __FlashStringHelper* text);
+    // start a scroller with the bytes of a function, called for every element as it scrolls into view
+    void setScroller(SegmentGenerator generator, unsigned int length);
     // start a scroller with custom symbols
     void setScroller(byte bytes[], int size);
-    // expand the the scroller with a text
-    void appendScroller(String text);
-    // expand the the scroller with a text
-    void appendScroller(byte bytes[], int size);
-
-    // change an element of the scroller
-    void setScrollElement(byte index, byte b);
+    // expand the the scroller with a text while it scrolls, returns the amount of characters that fit (the rest has to be sent again later)
+    int appendScroller(const String& text);
+    // expand the the scroller with a text while it scrolls (copied), returns the amount of characters that fit
+    int appendScroller(const char* text);
+    // expand the the scroller with custom symbols while it scrolls, returns the amount of bytes that fit
+    int appendScroller(byte bytes[], int size);
+    // get the amount of bytes that can be appended right now
+    unsigned int getScrollerSpace();
+    // repeat the text (default) or stream it: bytes that left the display are dropped and free their space, the scroller waits for new bytes
+    void setScrollerLoop(bool value);
+    // check if the scroller repeats the text
+    bool getScrollerLoop();
+
+    // play a timeline of frames in flash on the clock of the controller (frames that were missed are skipped), once or in a loop
+    void playTimeline(const SegmentFrame* frames, byte count, bool loop = false);
+    // stop the timeline, the current frame stays
+    void stopTimeline();
+    // check if a timeline is playing
+    bool isTimelinePlaying();
+    // get the index of the current frame of the timeline
+    byte getTimelineFrame();
+
+    // show a variable or the value of a function: update()/refresh() samples it every sampleTime milliseconds and only writes the digits when the shown value changes, scale > 0 shows value / 10^scale
+    void bindValue(const volatile long* value, byte scale = 0, unsigned int sampleTime = 250);
+    void bindValue(const volatile int* value, byte scale = 0, unsigned int sampleTime = 250);
+    void bindValue(SegmentValueSource source, byte scale = 0, unsigned int sampleTime = 250);
+    // stop showing the bound value (every set function stops it too), the last value stays
+    void unbindValue();
+    // check if a value is bound
+    bool isValueBound();
+    // only show a new value once it differs from the shown one by more than hysteresis (0: every change)
+    void setValueHysteresis(unsigned long hysteresis);
+    // show an exponential moving average: every sample moves it by 1/samples of the difference (1: no average),
+    // the sum has to fit into 32 bits: at most 2^31 / 10^digits samples (21 on 8 digits), samples beyond the display count as its limit
+    void setValueAveraging(byte samples);
+
+    // change an element of the scroller (a text the scroller reads from is copied first, if it fits into MAXSCROLLERSIZE)
+    void setScrollElement(unsigned int index, byte b);
     // get an element of the scroller
-    byte getScrollElement(byte index);
+    byte getScrollElement(unsigned int index);
     // get the length of the scroller
-    byte getScrollerLength();
+    unsigned int getScrollerLength();
     // set the time it takes to move to the next character
     void setScrollerUpdateTime(unsigned int updateTime);
     // get the time it takes to move to the next character
@@ -127,6 +380,27 @@ class SegmentController
     // check if a digit is blinking
     bool getBlinking(byte digitIndex);
 
+    // invert the segments of a digit (the dp stays)
+    void setInverted(byte digitIndex, bool value);
+    // invert the segments of all digits
+    void setInvertedAll(bool value);
+    // check if a digit is inverted
+    bool getInverted(byte digitIndex);
+
+    // fade a digit out and in again (one blink interval each)
+    void setFading(byte digitIndex, bool value);
+    // fade all digits
+    void setFadingAll(bool value);
+    // check if a digit is fading
+    bool getFading(byte digitIndex);
+
+    // only one of the chasing digits is shown at a time, from left to right (one blink interval each)
+    void setChasing(byte digitIndex, bool value);
+    // let all digits chase
+    void setChasingAll(bool value);
+    // check if a digit is chasing
+    bool getChasing(byte digitIndex);
+
     // set the interval for blinking
     void setBlinkInterval(unsigned int blinkInterval);
     // get the interval for blinking
@@ -139,62 +413,249 @@ class SegmentController
     // check if a number can be shown on the display
     bool isNumberInRange(int number);
     // check if a number can be shown on the display
+    bool isNumberInRange(long number);
+    // check if a number can be shown on the display
     bool isNumberInRange(float number);
     bool isDigitInRange(byte digitIndex);
     bool isSegmentInRange(byte segmentIndex);
+    // get the amount of digits
+    byte getDisplayLength();
 
 
 
-  private:
-    void setSegments(byte b);
-    void transformDigit(byte digitIndex, int shift);
+  protected:
+    void initialize(SegmentDigit* digits, SegmentDriver* driver, int digitPins[], byte displayLength, byte refreshTime);
 
-    int getSegmentLength();
-    bool isCommonAnode();
-    bool isStringEmpty(String s);
+    SegmentDigit* _digitStates;
+    SegmentDriver* _driver;
+    // amount of digits
+    byte _displayLength = MAXDIGITS;
 
+  private:
+    void update();
+    void pushFrame();
+    void showDigit(byte index);
+    void hideDigit(byte index);
+    bool isDigitVisible(byte index);
+    byte getFrameByte(byte index);
+    void setLayer(byte& layer, byte b);
+    void nextSlot();
+    void resetScan();
+    SEGMENT_MASK_TYPE getPart(SEGMENT_MASK_TYPE bits, byte part, byte limit);
+    byte countBits(SEGMENT_MASK_TYPE bits);
+    void startFrame();
+    void adaptSlotTime(unsigned long frameTime);
+    void setSlotTime(unsigned long slotTime);
+    void updateEffects();
+    void setEffect(SEGMENT_MASK_TYPE& mask, byte digitIndex, bool value);
+    bool getEffect(SEGMENT_MASK_TYPE mask, byte digitIndex);
+    void hideSlot();
+    byte getSlotCount(bool segmentScan);
+    void publishFrame();
+    void swapFrame();
+    void transformDigit(byte digitIndex, int shift);
+    byte getLevel(byte brightness);
+    void wait(unsigned long time);
+
+    void showText(const char* text, bool flash, unsigned int length, int shift);
+    bool isStringEmpty(const String& s);
+    bool formatNumber(unsigned long number, bool negative, byte base, byte minDigits, bool alignLeft);
+    bool formatFixed(long value, byte scale);
+    unsigned long getNumberLimit();
+
+    void startScroller(byte sourceType, unsigned int sourceLength);
+    bool copyScrollerSource();
+    bool padScroller();
     void updateScroller();
-    void disableScroller();
+    void showScroller();
+    void updateTimeline();
+    void showTimelineFrame();
+    void setTimelineEffects(byte effects);
+    void bind(byte type, byte scale, unsigned int sampleTime);
+    long readBinding();
+    void updateBinding();
+    void stopAnimations();
     
     
 
-    // display type: common cathode = 0, command anode = 1
-    int _commonPinType = 0;
-    // a, b, c, d, e, f, g, dp
-    int _segmentPins[8];
-    // digit pins in ascending order (D1, D2, ...)
-    int _digitPins[MAXDIGITS];
-    // amount of digits
-    byte _displayLength = MAXDIGITS;
 
     // time (in milliseconds) to refresh the display
     byte _refreshTime = 2;
+    byte _refreshMode = REFRESH_BLOCKING;
+    byte _scanMode = SCAN_DIGITS;
+    bool _segmentScan = false;
+    // current slot of the non-blocking scan (digit scan: 0 to _displayLength, the last slot keeps all digits off / segment scan: the segment)
+    volatile byte _scanSlot = 0;
+    volatile bool _slotLit = false;
+    unsigned long _slotStart = 0;
+    // time (in microseconds) of the current phase in the non-blocking scan
+    unsigned long _phaseTime = 0;
+    // bit planes left in the current slot, time (in microseconds) of the shortest plane
+    volatile byte _scanPlane = 0;
+    unsigned long _planeTime = 0;
+    // time (in microseconds) of a slot: the refresh time or adapted to hold _frameRate, start of the current frame
+    unsigned long _slotTime = 2000;
+    unsigned int _frameRate = 0;
+    unsigned int _minFrameRate = 0;
+    unsigned long _frameStart = 0;
+    // the current slot is split into bit planes
+    bool _slotDimmed = false;
+    // parts of the current slot (segment limit): the lit segments (digit scan) or digits (segment scan) of the slot and of the current part
+    volatile byte _scanPart = 0;
+    byte _slotParts = 1;
+    SEGMENT_MASK_TYPE _slotBits = 0;
+    SEGMENT_MASK_TYPE _partBits = 0;
+    byte _segmentLimit = 0;
+    bool _segmentEqualization = false;
     // time (in milliseconds) to blinking a digits
     unsigned int _blinkInterval = 250;
     byte _brightness = 255;
-    bool _hasDP = true;
 
-    // bytes currently displayed on the device
-    byte _displayedBytes[MAXDIGITS];
-    
+    // the scan reads the front frame (index of SegmentDigit::frames), finished frames wait in the other one until the scan starts over
+    volatile byte _frontFrame = 0;
+    volatile bool _framePending = false;
+    bool _frameDirty = false;
+
+    // effects, one bit per digit (bit 0 = right-most digit)
+    SEGMENT_MASK_TYPE _enabledDigits = (SEGMENT_MASK_TYPE)~0;
+    SEGMENT_MASK_TYPE _blinkingDigits = 0;
+    SEGMENT_MASK_TYPE _invertedDigits = 0;
+    SEGMENT_MASK_TYPE _fadingDigits = 0;
+    SEGMENT_MASK_TYPE _chasingDigits = 0;
+    // the effects evaluated once per frame: visible digits, dimmed digits and the digits lit in every bit plane
+    SEGMENT_MASK_TYPE _visibleDigits = 0;
+    SEGMENT_MASK_TYPE _dimmedDigits = 0;
+    SEGMENT_MASK_TYPE _planeDigits[SEGMENT_BCM_BITS];
 
-    bool _digitBlinking[MAXDIGITS];
-    bool _digitEnabled[MAXDIGITS];
 
+    enum { SOURCE_NONE, SOURCE_TEXT, SOURCE_FLASH, SOURCE_GENERATOR };
 
     bool _isScrolling = false;
+    bool _scrollerLoop = true;
+    // text the scroller reads from while it scrolls (not copied), the elements from _sourceStart on are left
+    byte _sourceType = SOURCE_NONE;
+    const char* _sourceText = NULL;
+    SegmentGenerator _sourceGenerator = NULL;
+    unsigned int _sourceStart = 0;
+    unsigned int _sourceLength = 0;
+    // ring buffer for copied and appended bytes (after the text): starts at _ringStart and wraps around at the end
     byte _scroller[MAXSCROLLERSIZE];
-    byte _scrollerLength = 0;
-    byte _currentScrollIndex = 0;
+    unsigned int _ringStart = 0;
+    unsigned int _ringLength = 0;
+    // element of the text on the right-most digit (-1: the text starts with the next step)
+    int _scrollPosition = -1;
+
+    // timeline in flash, the current frame and the time (in milliseconds) it started, effects set by the current frame
+    const SegmentFrame* _timeline = NULL;
+    byte _timelineLength = 0;
+    byte _timelineFrame = 0;
+    bool _timelineLoop = false;
+    bool _timelinePlaying = false;
+    unsigned long _timelineStart = 0;
+    byte _timelineEffects = 0;
+
+    enum { BIND_NONE, BIND_LONG, BIND_INT, BIND_SOURCE };
+
+    // bound value: variable or function, format, time (in milliseconds) between two samples and of the last one
+    byte _bindType = BIND_NONE;
+    const volatile void* _bindValue = NULL;
+    SegmentValueSource _bindSource = NULL;
+    byte _bindScale = 0;
+    unsigned int _bindSampleTime = 250;
+    unsigned long _previousBindTime = 0;
+    // filter: sum of the moving average (_bindAveraging times the average) and if it has a sample, hysteresis around the shown value
+    byte _bindAveraging = 1;
+    long _bindSum = 0;
+    bool _bindSampled = false;
+    unsigned long _bindHysteresis = 0;
+    long _bindShown = 0;
+    bool _bindShowing = false;
+
+    // next digit of print() and if the next print() starts over
+    byte _printCursor = 0;
+    bool _printNewLine = true;
+    // the printed line didn't fit, the rest of it is dropped
+    bool _printOverflow = false;
     unsigned int _scrollUpdateTime = 300;
     unsigned long _previousScrollTime;
 
 
-    // all digits from 0-9 and off
-    const byte _digits[11] = { 0b00111111, 0b00000110, 0b01011011, 0b01001111, 0b01100110, 0b01101101, 0b01111101, 0b00000111, 0b01111111, 0b01101111, 0b00000000 };
-    // the alphabet
-    const byte _alphabet[26] = { 0b01110111, 0b01111100, 0b01011000, 0b01011110, 0b01111001, 0b01110001, 0b00111101, 0b01110100, 0b00000100, 0b00011110, 0b01110101, 0b00111000, 0b01010101, 0b01010100, 0b01011100, 0b01110011, 0b01100111, 0b01010000, 0b00101101, 0b01111000, 0b00011100, 0b00101010, 0b01101010, 0b01110110, 0b01101110, 0b00011011 };
-    // some special characters: , ! ? = > < ( ) / \ * " ^  
-    const byte _specialCharacters[13] = { 0b00001100, 0b10000010, 0b01010011, 0b01001000, 0b01001100, 0b01011000, 0b00111001, 0b00001111, 0b01010010, 0b01100100, 0b01100011, 0b00100010, 0b00100011 };
+#ifdef SEGMENT_STATS
+    unsigned long _statsStart = 0;
+    volatile unsigned long _statsFrames = 0;
+    volatile unsigned long _statsScans = 0;
+    volatile unsigned long _statsLastScan = 0;
+    volatile unsigned long _statsGapSum = 0;
+    volatile unsigned long _statsMaxGap = 0;
+    unsigned long _statsMissedDeadlines = 0;
+    unsigned long _statsRefreshTime = 0;
+    unsigned long _statsMaxRefreshTime = 0;
+    unsigned long _statsDroppedScrollSteps = 0;
+#endif
+
+
+    // font (shared, in flash)
+    static const byte _digits[11];
+    static const byte _alphabet[26];
+    static const byte _specialCharacters[13];
+    // perceived brightness (in steps of 8) to on-time
+    static const byte _gamma[32];
+};
+
+// controller for up to MAXDIGITS digits configured at runtime, connected to the pins of the controller
+class SegmentController : public SegmentControllerBase
+{
+  public:
+    SegmentController(bool commonAnode, int segmentPins[8], int digitPins[], byte displayLength, byte refreshTime);
+    SegmentController(const SegmentController& other);
+    SegmentController& operator=(const SegmentController& other);
+
+  private:
+    SegmentDigit _storage[MAXDIGITS];
+    SegmentGpioDriver _gpio;
+};
+
+// controller for up to MAXDIGITS digits connected through a driver (e.g. SegmentShiftRegisterDriver, SegmentMax7219Driver), keeps no pin driver of its own
+class SegmentDriverController : public SegmentControllerBase
+{
+  public:
+    SegmentDriverController(SegmentDriver& driver, byte displayLength, byte refreshTime);
+    SegmentDriverController(const SegmentDriverController& other);
+    SegmentDriverController& operator=(const SegmentDriverController& other);
+
+  private:
+    SegmentDigit _storage[MAXDIGITS];
+};
+
+// controller with the amount of digits, display type and dp fixed at compile time, only keeps storage for its own digits
+template <byte Digits, bool CommonAnode, bool HasDP = true>
+class StaticSegmentController : public SegmentControllerBase
+{
+  static_assert(Digits > 0 && Digits <= MAXDIGITS, "Digits has to be between 1 and MAXDIGITS");
+
+  public:
+    StaticSegmentController(int segmentPins[8], int digitPins[Digits], byte refreshTime) : _gpio(segmentPins)
+    {
+      initialize(_storage, &_gpio, digitPins, Digits, refreshTime);
+    }
+    StaticSegmentController(const StaticSegmentController& other) : SegmentControllerBase(other), _gpio(other._gpio)
+    {
+      *this = other;
+    }
+    StaticSegmentController& operator=(const StaticSegmentController& other)
+    {
+      SegmentControllerBase::operator=(other);
+      for (int i = 0; i < Digits; i++)
+        _storage[i] = other._storage[i];
+      _gpio = other._gpio;
+      _digitStates = _storage;
+      _driver = &_gpio;
+      _gpio.begin(_storage, Digits);
+      return *this;
+    }
+
+  private:
+    SegmentDigit _storage[Digits];
+    StaticSegmentGpioDriver<CommonAnode, HasDP> _gpio;
 };
 #endif
\ No newline at end of file
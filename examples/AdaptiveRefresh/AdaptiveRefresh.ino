@@ -0,0 +1,65 @@
+/*
+  DonutStudioSevenSegment.h - Library for controlling a seven-segment-display with multiple digits.
+  Created by Donut Studio, December 30, 2023.
+  Released into the public domain.
+*/
+
+/*
+--- seven segment display ---
+
+       D1        D2       D3        D4        
+
+       -A-
+    |       |
+    F       B
+    |       |
+       -G-
+    |       |
+    E       C
+    |       |
+       -D-
+            - 
+            dp
+*/
+
+
+// include the libraray
+#include "DonutStudioSevenSegment.h"
+
+// --- define the pins ---
+
+//                 a,  b, c, d, e, f,  g, dp
+int segments[] = { 8, 12, 4, 5, 3, 7, 13, 2 };
+//               d1, d2, d3, d4
+int digits[] = { 11, 10, 6, 9 };
+
+// create an instance of the contoller class: display type = common anode; 4 digits, 2ms refresh time
+SegmentController disp = SegmentController(true, segments, digits, 4, 2);
+
+void setup() 
+{
+  Serial.begin(9600);
+
+  disp.setInt(1234);
+  disp.setRefreshMode(REFRESH_NONBLOCKING);
+
+  // hold 100 frames per second, never less than 60 (the slot time is measured and adapted every frame)
+  disp.setFrameRate(100, 60);
+}
+void loop() 
+{
+  // refresh the display in the loop
+  disp.refresh();
+
+  // the application: a varying load between the refresh calls
+  delayMicroseconds(random(50, 1500));
+
+  static unsigned long previousTime = 0;
+  if (millis() - previousTime > 1000)
+  {
+    previousTime = millis();
+    Serial.print(F("slot time: "));
+    Serial.print(disp.getSlotTime());
+    Serial.println(F(" us"));
+  }
+}
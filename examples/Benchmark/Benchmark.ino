@@ -0,0 +1,175 @@
+/*
+  DonutStudioSevenSegment.h - Library for controlling a seven-segment-display with multiple digits.
+  Created by Donut Studio, December 30, 2023.
+  Released into the public domain.
+*/
+
+/*
+--- seven segment display ---
+
+       D1        D2       D3        D4        
+
+       -A-
+    |       |
+    F       B
+    |       |
+       -G-
+    |       |
+    E       C
+    |       |
+       -D-
+            - 
+            dp
+*/
+
+
+// include the libraray
+#include "DonutStudioSevenSegment.h"
+
+// --- define the pins ---
+
+//                 a,  b, c, d, e, f,  g, dp
+int segments[] = { 8, 12, 4, 5, 3, 7, 13, 2 };
+//               d1, d2, d3, d4
+int digits[] = { 11, 10, 6, 9 };
+
+// create an instance of the contoller class: display type = common anode; 4 digits, 2ms refresh time
+SegmentController disp = SegmentController(true, segments, digits, 4, 2);
+
+
+// amount of calls every measurement is averaged over
+#define RUNS 1000
+
+// print the average time (in microseconds) of a call
+void report(const __FlashStringHelper* name, unsigned long start)
+{
+  unsigned long time = micros() - start;
+  Serial.print(name);
+  Serial.print(F(": "));
+  Serial.print(time / (float)RUNS, 2);
+  Serial.println(F(" us"));
+}
+
+void setup() 
+{
+  Serial.begin(9600);
+  Serial.println(F("--- BENCHMARK ---"));
+
+  unsigned long start = micros();
+  for (int i = 0; i < RUNS; i++)
+    disp.setInt(i);
+  report(F("setInt"), start);
+
+  start = micros();
+  for (int i = 0; i < RUNS; i++)
+    disp.setString("HeLo");
+  report(F("setString"), start);
+
+  start = micros();
+  for (int i = 0; i < RUNS; i++)
+    disp.setFloat(i / 10.0, 1);
+  report(F("setFloat"), start);
+
+  start = micros();
+  for (int i = 0; i < RUNS; i++)
+  {
+    disp.print(i);
+    disp.println();
+  }
+  report(F("print"), start);
+
+  // a new frame for every call: the frame is translated for the pins
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  start = micros();
+  for (int i = 0; i < RUNS; i++)
+  {
+    disp.setInt(i);
+    disp.refresh();
+  }
+  report(F("setInt + new frame"), start);
+
+  // the cost of scan() is the time the timer interrupt takes
+  disp.setInt(1234);
+  disp.refresh();
+  start = micros();
+  for (int i = 0; i < RUNS; i++)
+    disp.scan();
+  report(F("scan (digit scan)"), start);
+
+  disp.setScanMode(SCAN_SEGMENTS);
+  start = micros();
+  for (int i = 0; i < RUNS; i++)
+    disp.scan();
+  report(F("scan (segment scan)"), start);
+
+  disp.setScanMode(SCAN_DIGITS);
+  disp.setBrightness(100);
+  start = micros();
+  for (int i = 0; i < RUNS; i++)
+    disp.scan();
+  report(F("scan (dimmed)"), start);
+  disp.setBrightness(255);
+
+  // refresh() without a due slot: the cost for the main loop
+  disp.setRefreshMode(REFRESH_NONBLOCKING);
+  start = micros();
+  for (int i = 0; i < RUNS; i++)
+    disp.refresh();
+  report(F("refresh (non-blocking)"), start);
+
+  // frame rate and duty cycle of D1, measured: its pin is read while the loop refreshes (common anode: high = lit)
+  unsigned long samples = 0;
+  unsigned long litSamples = 0;
+  unsigned long frames = 0;
+  bool wasLit = false;
+  start = millis();
+  while (millis() - start < 1000)
+  {
+    disp.refresh();
+    bool lit = digitalRead(digits[0]) == HIGH;
+    samples++;
+    if (lit)
+      litSamples++;
+    // a new frame lights the digit again
+    if (lit && !wasLit)
+      frames++;
+    wasLit = lit;
+  }
+  Serial.print(F("frames per second: "));
+  Serial.println(frames);
+  Serial.print(F("duty cycle of D1: "));
+  Serial.print(litSamples * 100.0 / samples, 1);
+  Serial.println(F(" %"));
+
+#ifdef SEGMENT_STATS
+  disp.resetStats();
+#endif
+}
+void loop() 
+{
+  // refresh the display in the loop
+  disp.refresh();
+
+#ifdef SEGMENT_STATS
+  // the counters measured while the loop runs (SEGMENT_STATS has to be defined for the library, e.g. in DonutStudioSegmentDrivers.h)
+  static unsigned long previousTime = 0;
+  if (millis() - previousTime > 2000)
+  {
+    previousTime = millis();
+    SegmentStats stats = disp.getStats();
+    Serial.print(F("fps: "));
+    Serial.print(stats.frameRate);
+    Serial.print(F(", max gap: "));
+    Serial.print(stats.maxScanGap);
+    Serial.print(F(" us, average gap: "));
+    Serial.print(stats.averageScanGap);
+    Serial.print(F(" us, missed: "));
+    Serial.print(stats.missedDeadlines);
+    Serial.print(F(", max refresh: "));
+    Serial.print(stats.maxRefreshTime);
+    Serial.print(F(" us, pin writes per frame: "));
+    Serial.println(stats.frames > 0 ? stats.pinWrites / stats.frames : 0);
+    disp.resetStats();
+  }
+#endif
+}
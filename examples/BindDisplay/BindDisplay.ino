@@ -0,0 +1,59 @@
+/*
+  DonutStudioSevenSegment.h - Library for controlling a seven-segment-display with multiple digits.
+  Created by Donut Studio, December 30, 2023.
+  Released into the public domain.
+*/
+
+/*
+--- seven segment display ---
+
+       D1        D2       D3        D4        
+
+       -A-
+    |       |
+    F       B
+    |       |
+       -G-
+    |       |
+    E       C
+    |       |
+       -D-
+            - 
+            dp
+*/
+
+
+// include the libraray
+#include "DonutStudioSevenSegment.h"
+
+// --- define the pins ---
+
+//                 a,  b, c, d, e, f,  g, dp
+int segments[] = { 8, 12, 4, 5, 3, 7, 13, 2 };
+//               d1, d2, d3, d4
+int digits[] = { 11, 10, 6, 9 };
+
+// create an instance of the contoller class: display type = common anode; 4 digits, 2ms refresh time
+SegmentController disp = SegmentController(true, segments, digits, 4, 2);
+
+// temperature in tenths of a degree from an LM35 (10mV per degree) on A0
+long readTemperature()
+{
+  return analogRead(A0) * 5000L / 1023;
+}
+
+void setup() 
+{
+  // show the temperature with one decimal, sampled every 200ms
+  disp.bindValue(readTemperature, 1, 200);
+  // smooth the samples (every one moves the average by 1/8) and ignore changes of 0.1 degrees
+  disp.setValueAveraging(8);
+  disp.setValueHysteresis(1);
+
+  //disp.bindValue(&counter); // or show a variable (e.g. counted in an interrupt)
+}
+void loop() 
+{
+  // refresh the display in the loop, the value is only written when it changed
+  disp.refresh();
+}
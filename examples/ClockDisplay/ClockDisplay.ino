@@ -0,0 +1,61 @@
+/*
+  DonutStudioSevenSegment.h - Library for controlling a seven-segment-display with multiple digits.
+  Created by Donut Studio, December 30, 2023.
+  Released into the public domain.
+*/
+
+/*
+--- seven segment display ---
+
+       D1        D2       D3        D4        
+
+       -A-
+    |       |
+    F       B
+    |       |
+       -G-
+    |       |
+    E       C
+    |       |
+       -D-
+            - 
+            dp
+*/
+
+
+// include the libraray
+#include "DonutStudioSevenSegment.h"
+#include "DonutStudioSegmentCounter.h"
+
+// --- define the pins ---
+
+//                 a,  b, c, d, e, f,  g, dp
+int segments[] = { 8, 12, 4, 5, 3, 7, 13, 2 };
+//               d1, d2, d3, d4
+int digits[] = { 11, 10, 6, 9 };
+
+// create an instance of the contoller class: display type = common anode; 4 digits, 2ms refresh time
+SegmentController disp = SegmentController(true, segments, digits, 4, 2);
+
+// clock HH:MM on the first four digits, the dp of the 2nd digit is the colon
+SegmentClock segmentClock = SegmentClock(disp, CLOCK_HOURS_MINUTES);
+//SegmentClock segmentClock = SegmentClock(disp, CLOCK_MINUTES_SECONDS); // timer MM:SS
+
+void setup() 
+{
+  segmentClock.setTime(12, 59, 50);
+  segmentClock.setColonBlinking(true);
+}
+void loop() 
+{
+  // one tick per second, the digits only change when a minute is over
+  static unsigned long previousTime = 0;
+  if (millis() - previousTime >= 1000)
+  {
+    previousTime += 1000;
+    segmentClock.tickSecond();
+  }
+
+  // refresh the display in the loop
+  disp.refresh();
+}
@@ -0,0 +1,60 @@
+/*
+  DonutStudioSevenSegment.h - Library for controlling a seven-segment-display with multiple digits.
+  Created by Donut Studio, December 30, 2023.
+  Released into the public domain.
+*/
+
+/*
+--- seven segment display ---
+
+       D1        D2       D3        D4        
+
+       -A-
+    |       |
+    F       B
+    |       |
+       -G-
+    |       |
+    E       C
+    |       |
+       -D-
+            - 
+            dp
+*/
+
+
+// include the libraray
+#include "DonutStudioSevenSegment.h"
+#include "DonutStudioSegmentCounter.h"
+
+// --- define the pins ---
+
+//                 a,  b, c, d, e, f,  g, dp
+int segments[] = { 8, 12, 4, 5, 3, 7, 13, 2 };
+//               d1, d2, d3, d4
+int digits[] = { 11, 10, 6, 9 };
+
+// create an instance of the contoller class: display type = common anode; 4 digits, 2ms refresh time
+SegmentController disp = SegmentController(true, segments, digits, 4, 2);
+
+// counter on all digits, only the digits that change are written
+SegmentCounter counter = SegmentCounter(disp);
+
+void setup() 
+{
+  counter.set(990);
+}
+void loop() 
+{
+  // count up every 100ms: 990, 991, ... 999, 1000 (the carry runs through to the left)
+  static unsigned long previousTime = 0;
+  if (millis() - previousTime >= 100)
+  {
+    previousTime += 100;
+    counter.increment();
+    //counter.add(-5); // count down by 5
+  }
+
+  // refresh the display in the loop
+  disp.refresh();
+}
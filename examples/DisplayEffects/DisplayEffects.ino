@@ -42,6 +42,9 @@ void setup()
 
   disp.setDigitState(1, false); // disable the 2nd digit
   disp.setBlinking(2, true); // let the 3rd digit blink
+  //disp.setInverted(0, true); // invert the segments of the 1st digit
+  //disp.setFading(3, true); // fade the 4th digit out and in
+  //disp.setChasingAll(true); // show one digit after another
 
   disp.setBlinkInterval(100); // set the blink interval
 
@@ -49,6 +49,9 @@ void setup()
 {
   Serial.begin(9600);
 
+  // light one digit per refresh() call instead of waiting for the whole display
+  disp.setRefreshMode(REFRESH_NONBLOCKING);
+
   Serial.println("--- INTEGER ---");
   disp.setInt(1234);
 
@@ -96,8 +99,8 @@ void loop()
         disp.setBrightness(75);
         break;
       case 6:
-        Serial.println("--- BRIGHTNESS ---");
-        disp.setBrightness(25);
+        Serial.println("--- DIGIT BRIGHTNESS ---");
+        disp.setDigitBrightness(0, 25);
         break;
 
 
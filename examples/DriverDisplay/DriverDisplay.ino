@@ -0,0 +1,49 @@
+/*
+  DonutStudioSevenSegment.h - Library for controlling a seven-segment-display with multiple digits.
+  Created by Donut Studio, December 30, 2023.
+  Released into the public domain.
+*/
+
+/*
+--- seven segment display ---
+
+       D1        D2       D3        D4        
+
+       -A-
+    |       |
+    F       B
+    |       |
+       -G-
+    |       |
+    E       C
+    |       |
+       -D-
+            - 
+            dp
+*/
+
+
+// include the libraray
+#include "DonutStudioSevenSegment.h"
+
+// --- define the driver ---
+
+// two chained 74HC595: segments on the first one (Q0 = a ... Q7 = dp), digits on the second one (Q0 = D1, Q1 = D2, ...)
+// display type = common anode; data pin 11, clock pin 13, latch pin 10
+SegmentShiftRegisterDriver driver = SegmentShiftRegisterDriver(true, 11, 13, 10);
+
+// or a MAX7219 that scans the display on its own: data pin 11, clock pin 13, load pin 10
+//SegmentMax7219Driver driver = SegmentMax7219Driver(11, 13, 10);
+
+// create an instance of the contoller class with the driver: 4 digits, 2ms refresh time
+SegmentDriverController disp = SegmentDriverController(driver, 4, 2);
+
+void setup() 
+{
+  disp.setInt(1234);
+}
+void loop() 
+{
+  // refresh the display in the loop (only hands over new frames to the MAX7219)
+  disp.refresh();
+}
@@ -38,7 +38,12 @@ SegmentController disp = SegmentController(true, segments, digits, 4, 2);
 
 void setup() 
 {
-  // not available currently
+  disp.setFloat(3.14159); // will display '3.14'    identical to disp.setFloat(3.14159, 2);
+  //disp.setFloat(3.14159, 3); // will display '3.142'
+  //disp.setFloat(-1.5, 1); // will display ' -1.5'
+  //disp.setFloat(123.456, 3); // will display '123.5' (decimals are dropped until the number fits)
+  //disp.setFixed(2150, 2); // will display '21.50'
+  //disp.setFixed(5, 2); // will display '0.05'
 }
 void loop() 
 {
@@ -35,6 +35,8 @@ int digits[] = { 11, 10, 6, 9 };
 
 // create an instance of the contoller class: display type = common anode; 4 digits, 2ms refresh time
 SegmentController disp = SegmentController(true, segments, digits, 4, 2);
+// or fix the amount of digits and the display type at compile time: only keeps memory for 4 digits
+//StaticSegmentController<4, true> disp(segments, digits, 2);
 
 void setup() 
 {
@@ -42,6 +44,9 @@ void setup()
   //disp.setInt(420, true); // will display '0420'
   //disp.setInt(-2); // will display '  -2'
   //disp.setInt(-2, true); // will display '-002';
+  //disp.setHex(0xBEEF); // will display 'beef'
+  //disp.setBinary(5, true); // will display '0101'
+  //disp.setNumber(42, DEC, false, true); // will display '42  '
 }
 void loop() 
 {
@@ -0,0 +1,70 @@
+/*
+  DonutStudioSevenSegment.h - Library for controlling a seven-segment-display with multiple digits.
+  Created by Donut Studio, December 30, 2023.
+  Released into the public domain.
+*/
+
+/*
+--- seven segment display ---
+
+       D1        D2       D3        D4        
+
+       -A-
+    |       |
+    F       B
+    |       |
+       -G-
+    |       |
+    E       C
+    |       |
+       -D-
+            - 
+            dp
+*/
+
+
+// include the libraray
+#include "DonutStudioSevenSegment.h"
+
+// --- define the pins ---
+
+//                 a,  b, c, d, e, f,  g, dp
+int segments[] = { 8, 12, 4, 5, 3, 7, 13, 2 };
+//               d1, d2, d3, d4
+int digits[] = { 11, 10, 6, 9 };
+
+// create an instance of the contoller class: display type = common anode; 4 digits, 2ms refresh time
+SegmentController disp = SegmentController(true, segments, digits, 4, 2);
+
+int counter = 0;
+
+void setup() 
+{
+  // the timer interrupt scans the display, refresh() only hands over new frames
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  disp.setInt(counter);
+
+  // timer2 (AVR, 16MHz): 16MHz / 128 = one tick every 8us, the first compare match after 2ms (250 ticks), then the time scan() returns
+  noInterrupts();
+  TCCR2A = bit(WGM21);
+  TCCR2B = bit(CS22) | bit(CS20);
+  OCR2A = 249;
+  TIMSK2 = bit(OCIE2A);
+  interrupts();
+}
+void loop() 
+{
+  // the display keeps running while the loop is busy
+  delay(1000);
+
+  counter++;
+  disp.setInt(counter);
+  disp.refresh();
+}
+
+ISR(TIMER2_COMPA_vect)
+{
+  // the phases of a dimmed digit are shorter than a slot: reload the timer with the time of the next one (8us ticks, at most 2ms)
+  unsigned long ticks = disp.scan() / 8;
+  OCR2A = ticks > 256 ? 255 : (ticks < 2 ? 1 : ticks - 1);
+}
@@ -0,0 +1,55 @@
+/*
+  DonutStudioSevenSegment.h - Library for controlling a seven-segment-display with multiple digits.
+  Created by Donut Studio, December 30, 2023.
+  Released into the public domain.
+*/
+
+/*
+--- seven segment display ---
+
+       D1        D2       D3        D4        
+
+       -A-
+    |       |
+    F       B
+    |       |
+       -G-
+    |       |
+    E       C
+    |       |
+       -D-
+            - 
+            dp
+*/
+
+
+// include the libraray
+#include "DonutStudioSevenSegment.h"
+
+// --- define the pins ---
+
+//                 a,  b, c, d, e, f,  g, dp
+int segments[] = { 8, 12, 4, 5, 3, 7, 13, 2 };
+//               d1, d2, d3, d4
+int digits[] = { 11, 10, 6, 9 };
+
+// create an instance of the contoller class: display type = common anode; 4 digits, 2ms refresh time
+SegmentController disp = SegmentController(true, segments, digits, 4, 2);
+
+void setup() 
+{
+  // unit on the last digit: the mask hides the content of the digit, the overlay shows a 'C'
+  disp.setMask(3, 0b11111111);
+  disp.setOverlay(3, disp.getCharacter('C'));
+}
+void loop() 
+{
+  // the content changes, the layers stay
+  disp.setNumber(millis() / 1000 % 1000, DEC, false, true);
+
+  // dp heartbeat on the first digit, only a change publishes a new frame
+  disp.setOverlaySegment(0, 7, millis() / 500 % 2);
+
+  // refresh the display in the loop
+  disp.refresh();
+}
@@ -0,0 +1,58 @@
+/*
+  DonutStudioSevenSegment.h - Library for controlling a seven-segment-display with multiple digits.
+  Created by Donut Studio, December 30, 2023.
+  Released into the public domain.
+*/
+
+/*
+--- seven segment display ---
+
+       D1        D2       D3        D4        
+
+       -A-
+    |       |
+    F       B
+    |       |
+       -G-
+    |       |
+    E       C
+    |       |
+       -D-
+            - 
+            dp
+*/
+
+
+// include the libraray
+#include "DonutStudioSevenSegment.h"
+#include "DonutStudioSegmentScheduler.h"
+
+// --- define the pins ---
+
+// both displays are connected to the same segment pins
+//                 a,  b, c, d, e, f,  g, dp
+int segments[] = { 8, 12, 4, 5, 3, 7, 13, 2 };
+//                d1, d2, d3, d4
+int digits1[] = { 11, 10, 6, 9 };
+int digits2[] = { A0, A1, A2, A3 };
+
+// create the displays: display type = common anode; 4 digits, 2ms refresh time
+SegmentController disp1 = SegmentController(true, segments, digits1, 4, 2);
+SegmentController disp2 = SegmentController(true, segments, digits2, 4, 2);
+
+// the scheduler scans all 8 digits, every digit is lit for 2ms
+SegmentScheduler scheduler = SegmentScheduler(2);
+
+void setup() 
+{
+  scheduler.addDisplay(disp1);
+  scheduler.addDisplay(disp2);
+
+  disp1.setInt(1234);
+  disp2.setString("Hey!");
+}
+void loop() 
+{
+  // refresh all displays in the loop (don't call refresh() of the displays)
+  scheduler.refresh();
+}
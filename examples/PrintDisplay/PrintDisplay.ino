@@ -0,0 +1,65 @@
+/*
+  DonutStudioSevenSegment.h - Library for controlling a seven-segment-display with multiple digits.
+  Created by Donut Studio, December 30, 2023.
+  Released into the public domain.
+*/
+
+/*
+--- seven segment display ---
+
+       D1        D2       D3        D4        
+
+       -A-
+    |       |
+    F       B
+    |       |
+       -G-
+    |       |
+    E       C
+    |       |
+       -D-
+            - 
+            dp
+*/
+
+
+// include the libraray
+#include "DonutStudioSevenSegment.h"
+
+// --- define the pins ---
+
+//                 a,  b, c, d, e, f,  g, dp
+int segments[] = { 8, 12, 4, 5, 3, 7, 13, 2 };
+//               d1, d2, d3, d4
+int digits[] = { 11, 10, 6, 9 };
+
+// create an instance of the contoller class: display type = common anode; 4 digits, 2ms refresh time
+SegmentController disp = SegmentController(true, segments, digits, 4, 2);
+
+
+int counter = 0;
+unsigned long previousTime = 0;
+
+void setup() 
+{
+  disp.print(F("Hi")); // print works like on Serial, text starts at the left-most digit
+}
+void loop() 
+{
+  if (millis() - previousTime > 1000)
+  {
+    previousTime = millis();
+    counter++;
+
+    // println: the next print starts over with an empty display
+    if (counter % 3 == 0)
+      disp.println(counter, HEX); // hexadecimal
+    else if (counter % 3 == 1)
+      disp.println(counter / 10.0, 1); // the dot goes onto the digit before
+    else
+      disp.printf("%3d\n", counter); // formatted, right aligned
+  }
+
+  // refresh the display in the loop
+  disp.refresh();
+}
@@ -45,7 +45,9 @@ void setup()
 {
   Serial.begin(9600);
 
-  disp.setScroller("Hey, text!"); // display 'hey, text!' on the device
+  disp.setScroller("Hey, text!"); // display 'hey, text!' on the device (copied)
+  //disp.setScrollerSource("a long text in RAM that stays alive"); // any length, read while it scrolls (not copied, keep it alive)
+  //disp.setScroller(F("a long text kept in flash, read character by character while it scrolls")); // no length limit
   disp.appendScroller(b, 4); // add some custom bytes to the scroll effect
   
   disp.setScrollerUpdateTime(500); // move to the next char in 500ms
@@ -0,0 +1,58 @@
+/*
+  DonutStudioSevenSegment.h - Library for controlling a seven-segment-display with multiple digits.
+  Created by Donut Studio, December 30, 2023.
+  Released into the public domain.
+*/
+
+/*
+--- seven segment display ---
+
+       D1        D2       D3        D4        
+
+       -A-
+    |       |
+    F       B
+    |       |
+       -G-
+    |       |
+    E       C
+    |       |
+       -D-
+            - 
+            dp
+*/
+
+
+// include the libraray
+#include "DonutStudioSevenSegment.h"
+
+// --- define the pins ---
+
+//                 a,  b, c, d, e, f,  g, dp
+int segments[] = { 8, 12, 4, 5, 3, 7, 13, 2 };
+//               d1, d2, d3, d4
+int digits[] = { 11, 10, 6, 9 };
+
+// create an instance of the contoller class: display type = common anode; 4 digits, 2ms refresh time
+SegmentController disp = SegmentController(true, segments, digits, 4, 2);
+
+
+void setup() 
+{
+  Serial.begin(9600);
+
+  disp.setScrollerLoop(false); // stream: characters that left the display free their space
+  disp.setScrollerUpdateTime(250); // move to the next char in 250ms
+}
+void loop() 
+{
+  // feed the scroller with the serial input, but only as much as fits (the rest waits in the serial buffer)
+  while (Serial.available() > 0 && disp.getScrollerSpace() > 0)
+  {
+    byte b = disp.getCharacter(Serial.read());
+    disp.appendScroller(&b, 1);
+  }
+
+  // refresh the display in the loop
+  disp.refresh();
+}
@@ -36,10 +36,14 @@ int digits[] = { 11, 10, 6, 9 };
 // create an instance of the contoller class: display type = common anode; 4 digits, 2ms refresh time
 SegmentController disp = SegmentController(true, segments, digits, 4, 2);
 
+// a text encoded by the compiler and kept in flash
+const SegmentText<4> hello PROGMEM = segmentText("HeLo");
+
 
 void setup() 
 {
   disp.setString("Hey!"); // display 'hey!' on the device
+  //disp.setByte_P(hello.bytes); // display 'helo' without translating any characters at runtime
 }
 void loop() 
 {
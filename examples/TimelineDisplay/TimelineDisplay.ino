@@ -0,0 +1,78 @@
+/*
+  DonutStudioSevenSegment.h - Library for controlling a seven-segment-display with multiple digits.
+  Created by Donut Studio, December 30, 2023.
+  Released into the public domain.
+*/
+
+/*
+--- seven segment display ---
+
+       D1        D2       D3        D4        
+
+       -A-
+    |       |
+    F       B
+    |       |
+       -G-
+    |       |
+    E       C
+    |       |
+       -D-
+            - 
+            dp
+*/
+
+
+// include the libraray
+#include "DonutStudioSevenSegment.h"
+
+// --- define the pins ---
+
+//                 a,  b, c, d, e, f,  g, dp
+int segments[] = { 8, 12, 4, 5, 3, 7, 13, 2 };
+//               d1, d2, d3, d4
+int digits[] = { 11, 10, 6, 9 };
+
+// create an instance of the contoller class: display type = common anode; 4 digits, 2ms refresh time
+SegmentController disp = SegmentController(true, segments, digits, 4, 2);
+
+
+// a segment running around the display: bytes of the digits (left to right), time in milliseconds, effects
+const SegmentFrame boot[] PROGMEM = 
+{
+  { { 0b00000001, 0, 0, 0 }, 80, 0 },
+  { { 0, 0b00000001, 0, 0 }, 80, 0 },
+  { { 0, 0, 0b00000001, 0 }, 80, 0 },
+  { { 0, 0, 0, 0b00000001 }, 80, 0 },
+  { { 0, 0, 0, 0b00000010 }, 80, 0 },
+  { { 0, 0, 0, 0b00000100 }, 80, 0 },
+  { { 0, 0, 0, 0b00001000 }, 80, 0 },
+  { { 0, 0, 0b00001000, 0 }, 80, 0 },
+  { { 0, 0b00001000, 0, 0 }, 80, 0 },
+  { { 0b00001000, 0, 0, 0 }, 80, 0 },
+  { { 0b00010000, 0, 0, 0 }, 80, 0 },
+  { { 0b00100000, 0, 0, 0 }, 80, 0 }
+};
+
+// an alarm: '8888' blinking, then dimmed
+const SegmentFrame alarm[] PROGMEM = 
+{
+  { { 0b01111111, 0b01111111, 0b01111111, 0b01111111 }, 2000, FRAME_BLINK },
+  { { 0b01111111, 0b01111111, 0b01111111, 0b01111111 }, 1000, FRAME_DIM }
+};
+
+
+void setup() 
+{
+  // play the boot animation once, the controller takes care of the timing
+  disp.playTimeline(boot, 12);
+}
+void loop() 
+{
+  // after the boot animation: loop the alarm
+  if (!disp.isTimelinePlaying() && disp.getTimelineFrame() == 11)
+    disp.playTimeline(alarm, 2, true);
+
+  // refresh the display in the loop (also moves the timeline)
+  disp.refresh();
+}
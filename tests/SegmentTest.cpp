@@ -0,0 +1,133 @@
+/*
+  SegmentTest.cpp - Pin trace helpers for the host tests and benchmarks of the library.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "SegmentTest.h"
+
+int segmentPins[8] = { 8, 12, 4, 5, 3, 7, 13, 2 };
+int digitPins[8] = { 11, 10, 6, 9, 14, 15, 16, 17 };
+
+/*
+  --- PINS ---
+*/
+
+byte litSegments(bool commonAnode)
+{
+  byte b = 0;
+  for (int i = 0; i < 8; i++)
+    if (Sim::level(segmentPins[i]) == segmentOnLevel(commonAnode))
+      b |= 1 << i;
+  return b;
+}
+unsigned int litDigits(bool commonAnode, byte displayLength)
+{
+  unsigned int digits = 0;
+  for (int i = 0; i < displayLength; i++)
+    if (Sim::level(digitPins[i]) == digitOnLevel(commonAnode))
+      digits |= 1 << i;
+  return digits;
+}
+
+unsigned long digitOnTime(byte digitIndex, bool commonAnode, unsigned long from, unsigned long to)
+{
+  return Sim::timeAtLevel(digitPins[digitIndex], digitOnLevel(commonAnode), from, to);
+}
+unsigned long digitOnEdges(byte digitIndex, bool commonAnode, unsigned long from, unsigned long to)
+{
+  return Sim::edgesToLevel(digitPins[digitIndex], digitOnLevel(commonAnode), from, to);
+}
+
+unsigned long segmentOnTime(byte digitIndex, byte segmentIndex, bool commonAnode, unsigned long from, unsigned long to)
+{
+  // replay the digit and the segment pin, a state lasts from its transition until the next one
+  int digitPin = digitPins[digitIndex];
+  int segmentPin = segmentPins[segmentIndex];
+  uint8_t digitLevel = Sim::startLevel(digitPin);
+  uint8_t segmentLevel = Sim::startLevel(segmentPin);
+
+  unsigned long time = 0;
+  unsigned long stateStart = 0;
+  const std::vector<Sim::Transition>& changes = Sim::transitions();
+  for (size_t i = 0; i <= changes.size(); i++)
+  {
+    unsigned long stateEnd = i < changes.size() ? changes[i].time : to;
+    unsigned long start = stateStart > from ? stateStart : from;
+    unsigned long end = stateEnd < to ? stateEnd : to;
+    if (end > start && digitLevel == digitOnLevel(commonAnode) && segmentLevel == segmentOnLevel(commonAnode))
+      time += end - start;
+    if (i == changes.size() || stateEnd >= to)
+      break;
+
+    if (changes[i].pin == digitPin)
+      digitLevel = changes[i].level;
+    else if (changes[i].pin == segmentPin)
+      segmentLevel = changes[i].level;
+    stateStart = stateEnd;
+  }
+  return time;
+}
+
+GhostStats findGhosts(const byte expected[], byte displayLength, bool commonAnode, unsigned long from, unsigned long to)
+{
+  GhostStats ghosts = { 0, 0 };
+
+  // replay every pin of the display, a state lasts until the next transition
+  uint8_t levels[NUM_DIGITAL_PINS];
+  for (int pin = 0; pin < NUM_DIGITAL_PINS; pin++)
+    levels[pin] = Sim::startLevel(pin);
+
+  const std::vector<Sim::Transition>& changes = Sim::transitions();
+  for (size_t i = 0; i < changes.size() && changes[i].time < to; i++)
+  {
+    levels[changes[i].pin] = changes[i].level;
+    unsigned long end = i + 1 < changes.size() && changes[i + 1].time < to ? changes[i + 1].time : to;
+    if (changes[i].time < from || end == changes[i].time)
+      continue;
+
+    byte segments = 0;
+    for (int s = 0; s < 8; s++)
+      if (levels[segmentPins[s]] == segmentOnLevel(commonAnode))
+        segments |= 1 << s;
+
+    bool ghost = false;
+    for (int d = 0; d < displayLength; d++)
+      if (levels[digitPins[d]] == digitOnLevel(commonAnode) && (segments & ~expected[d]) != 0)
+        ghost = true;
+    if (!ghost)
+      continue;
+
+    ghosts.windows++;
+    ghosts.time += end - changes[i].time;
+  }
+  return ghosts;
+}
+
+unsigned int maxLitLeds(byte displayLength, bool commonAnode, unsigned long from, unsigned long to)
+{
+  unsigned int maxLeds = 0;
+
+  uint8_t levels[NUM_DIGITAL_PINS];
+  for (int pin = 0; pin < NUM_DIGITAL_PINS; pin++)
+    levels[pin] = Sim::startLevel(pin);
+
+  const std::vector<Sim::Transition>& changes = Sim::transitions();
+  for (size_t i = 0; i < changes.size() && changes[i].time < to; i++)
+  {
+    levels[changes[i].pin] = changes[i].level;
+    unsigned long end = i + 1 < changes.size() && changes[i + 1].time < to ? changes[i + 1].time : to;
+    if (changes[i].time < from || end == changes[i].time)
+      continue;
+
+    unsigned int segments = 0;
+    for (int s = 0; s < 8; s++)
+      segments += levels[segmentPins[s]] == segmentOnLevel(commonAnode);
+    unsigned int digits = 0;
+    for (int d = 0; d < displayLength; d++)
+      digits += levels[digitPins[d]] == digitOnLevel(commonAnode);
+    if (segments * digits > maxLeds)
+      maxLeds = segments * digits;
+  }
+  return maxLeds;
+}
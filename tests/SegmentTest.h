@@ -0,0 +1,80 @@
+/*
+  SegmentTest.h - Checks and pin trace helpers for the host tests of the library.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+/*
+--- tests ---
+
+  every test file is its own program: TEST(name) { ... } registers a test, CHECK/CHECK_EQUAL report a failure and go on
+  the pins are the ones of the examples (4 digits: D1 = 11, D2 = 10, D3 = 6, D4 = 9), Sim::reset() runs before every test
+*/
+
+
+
+#ifndef SegmentTest_h
+#define SegmentTest_h
+
+#include "Arduino.h"
+
+
+typedef void (*TestFunction)();
+
+struct TestRegistration
+{
+  TestRegistration(const char* name, TestFunction function);
+};
+
+#define TEST(name) \
+  static void name(); \
+  static TestRegistration name##Registration(#name, name); \
+  static void name()
+
+#define CHECK(condition) \
+  checkResult((condition), #condition, __FILE__, __LINE__)
+#define CHECK_EQUAL(expected, actual) \
+  checkEqual((long)(expected), (long)(actual), #actual, __FILE__, __LINE__)
+// |actual - expected| <= tolerance
+#define CHECK_NEAR(expected, actual, tolerance) \
+  checkNear((double)(expected), (double)(actual), (double)(tolerance), #actual, __FILE__, __LINE__)
+
+void checkResult(bool passed, const char* text, const char* file, int line);
+void checkEqual(long expected, long actual, const char* text, const char* file, int line);
+void checkNear(double expected, double actual, double tolerance, const char* text, const char* file, int line);
+
+
+// pins of the examples: a, b, c, d, e, f, g, dp and the digits from the left (more digits for 6 and 8 digit displays)
+extern int segmentPins[8];
+extern int digitPins[8];
+
+// level of a digit pin while the digit is lit and of a segment pin while the segment is lit
+inline uint8_t digitOnLevel(bool commonAnode) { return commonAnode ? HIGH : LOW; }
+inline uint8_t segmentOnLevel(bool commonAnode) { return commonAnode ? LOW : HIGH; }
+
+// the segments lit right now (bit 0 = a) and the lit digits (bit 0 = left-most digit)
+byte litSegments(bool commonAnode);
+unsigned int litDigits(bool commonAnode, byte displayLength);
+
+// time (in microseconds) a digit was lit between from and to, and how often it was turned on
+unsigned long digitOnTime(byte digitIndex, bool commonAnode, unsigned long from, unsigned long to);
+unsigned long digitOnEdges(byte digitIndex, bool commonAnode, unsigned long from, unsigned long to);
+
+// time (in microseconds) a segment was lit on a digit between from and to: the digit and the segment pin both on
+unsigned long segmentOnTime(byte digitIndex, byte segmentIndex, bool commonAnode, unsigned long from, unsigned long to);
+
+// states of the trace where a lit digit showed a segment it doesn't have (e.g. the segments of the digit before) for some time:
+// set a write time (Sim::setWriteTime) to see the windows between the digitalWrite calls, writes at the same time don't count
+struct GhostStats
+{
+  // states (between two recorded transitions) with a ghost and their time (in microseconds)
+  unsigned long windows;
+  unsigned long time;
+};
+// expected: the bytes of the digits from the left
+GhostStats findGhosts(const byte expected[], byte displayLength, bool commonAnode, unsigned long from, unsigned long to);
+
+// the most LEDs lit at once between from and to (lit segment lines times lit digits), writes at the same time don't count
+unsigned int maxLitLeds(byte displayLength, bool commonAnode, unsigned long from, unsigned long to);
+
+#endif
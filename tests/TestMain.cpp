@@ -0,0 +1,69 @@
+/*
+  TestMain.cpp - Runs the tests registered with TEST() in a host test program.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "SegmentTest.h"
+
+namespace
+{
+  struct Test
+  {
+    const char* name;
+    TestFunction function;
+  };
+
+  // filled by the static registrations, before main()
+  Test tests[64];
+  int testCount = 0;
+  int failures = 0;
+  const char* currentTest = "";
+}
+
+TestRegistration::TestRegistration(const char* name, TestFunction function)
+{
+  if (testCount < 64)
+    tests[testCount++] = Test{ name, function };
+}
+
+void checkResult(bool passed, const char* text, const char* file, int line)
+{
+  if (passed)
+    return;
+  failures++;
+  printf("%s:%d: %s: CHECK(%s) failed\n", file, line, currentTest, text);
+}
+void checkEqual(long expected, long actual, const char* text, const char* file, int line)
+{
+  if (expected == actual)
+    return;
+  failures++;
+  printf("%s:%d: %s: %s is %ld, expected %ld\n", file, line, currentTest, text, actual, expected);
+}
+void checkNear(double expected, double actual, double tolerance, const char* text, const char* file, int line)
+{
+  if (fabs(actual - expected) <= tolerance)
+    return;
+  failures++;
+  printf("%s:%d: %s: %s is %g, expected %g (+-%g)\n", file, line, currentTest, text, actual, expected, tolerance);
+}
+
+
+/*
+  --- MAIN ---
+*/
+
+int main()
+{
+  for (int i = 0; i < testCount; i++)
+  {
+    currentTest = tests[i].name;
+    Sim::reset();
+    int before = failures;
+    tests[i].function();
+    printf("%s %s\n", failures == before ? "[ OK ]" : "[FAIL]", tests[i].name);
+  }
+  printf("%d tests, %d failed checks\n", testCount, failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+/*
+  adaptive_test.cpp - setFrameRate: the slot time is measured and adapted every frame to hold the frame rate under varying loop loads.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+
+static unsigned long randomState = 1;
+
+// the time the application spends between two refresh() calls: minLoad to maxLoad microseconds
+static unsigned long nextLoad(unsigned long minLoad, unsigned long maxLoad)
+{
+  randomState = randomState * 1103515245UL + 12345UL;
+  return minLoad + (randomState >> 8) % (maxLoad - minLoad + 1);
+}
+
+// a second of the loop after a second to settle in, the counters of the second one
+static SegmentStats runLoop(SegmentController& disp, unsigned long minLoad, unsigned long maxLoad)
+{
+  for (int second = 0; second < 2; second++)
+  {
+    disp.resetStats();
+    unsigned long start = micros();
+    while (micros() - start < 1000000UL)
+    {
+      disp.refresh();
+      Sim::advance(nextLoad(minLoad, maxLoad));
+    }
+  }
+  return disp.getStats();
+}
+
+TEST(holdsTheFrameRateUnderVaryingLoads)
+{
+  // constant, slightly and heavily varying loads, all of them shorter than a slot
+  const unsigned long loads[][2] = { { 10, 10 }, { 50, 50 }, { 50, 500 }, { 50, 1500 }, { 1000, 1000 } };
+  const unsigned int frameRates[] = { 60, 120, 180 };
+  for (int f = 0; f < 3; f++)
+    for (int i = 0; i < 5; i++)
+    {
+      Sim::reset();
+      SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+      disp.setRefreshMode(REFRESH_NONBLOCKING);
+      disp.setInt(1234);
+      disp.setFrameRate(frameRates[f], 50);
+      SegmentStats stats = runLoop(disp, loads[i][0], loads[i][1]);
+      CHECK_NEAR(frameRates[f], stats.frameRate, frameRates[f] / 50.0);
+      // no more scans than the frames need: the rest of the time belongs to the application
+      CHECK_NEAR(1000000.0 / frameRates[f] / 5, stats.averageScanGap, 1000000.0 / frameRates[f] / 5 / 50);
+    }
+}
+
+TEST(loopSlowerThanASlotSetsTheFrameRate)
+{
+  // every refresh() moves on by one slot: 5 loops of 3 ms per frame, the slot time goes down to the shortest one
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_NONBLOCKING);
+  disp.setInt(1234);
+  disp.setFrameRate(120, 50);
+  SegmentStats stats = runLoop(disp, 3000, 3000);
+  CHECK_NEAR(1000000.0 / (5 * 3000), stats.frameRate, 1);
+  CHECK_EQUAL(SEGMENT_MIN_SLOT_TIME, disp.getSlotTime());
+
+  // the load gets lighter again: back to the frame rate
+  stats = runLoop(disp, 50, 500);
+  CHECK_NEAR(120, stats.frameRate, 120 / 50.0);
+}
+
+TEST(minFrameRateLimitsTheSlotTime)
+{
+  // 30 frames would need slots of 6.7 ms, the slots stay short enough for 50 frames
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_NONBLOCKING);
+  disp.setInt(1234);
+  disp.setFrameRate(30, 50);
+  SegmentStats stats = runLoop(disp, 50, 50);
+  CHECK(disp.getSlotTime() <= 1000000UL / 50 / 5);
+  CHECK(stats.frameRate >= 49);
+}
+
+TEST(withoutFrameRateTheRefreshTimeStays)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 3);
+  disp.setRefreshMode(REFRESH_NONBLOCKING);
+  disp.setInt(1234);
+  SegmentStats stats = runLoop(disp, 50, 1500);
+  CHECK_EQUAL(3000, disp.getSlotTime());
+  CHECK_NEAR(1000000.0 / (5 * 3000), stats.frameRate, 1);
+}
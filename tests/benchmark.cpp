@@ -0,0 +1,294 @@
+/*
+  benchmark.cpp - Frame rate, duty cycle, pin writes, ghosting and CPU time of the scan on the host.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+/*
+--- benchmark ---
+
+  every configuration runs one second of virtual time in REFRESH_NONBLOCKING, the loop calls refresh() every LOOP_TIME microseconds,
+  a digitalWrite takes WRITE_TIME microseconds (like on a 16 MHz AVR), writes to the port registers take no time
+  fps            frames counted by the controller (getStats)
+  duty           time every digit was lit (pin trace), from the left
+  writes/frame   pins written by the driver / digitalWrite calls / recorded level changes, per frame
+  ghost          states of the trace where a lit digit showed a segment it doesn't have, and their time
+  ns/refresh     host CPU time of a refresh() call (ns), the set functions below (setInt and isNumberInRange also with pow() like before)
+  frame          host CPU time and digitalWrite calls of the output of one frame, bit by bit like before the translation and translated
+  sizeof         memory of the controllers and drivers on the host
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+#include <chrono>
+
+#define LOOP_TIME 50
+#define WRITE_TIME 4
+#define RUN_TIME 1000000UL
+#define CALLS 100000
+
+typedef std::chrono::steady_clock Clock;
+
+double nanoseconds(Clock::time_point start, unsigned long calls)
+{
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / calls;
+}
+
+void run(const char* name, byte displayLength, byte scanMode, byte brightness)
+{
+  Sim::reset();
+  Sim::setWriteTime(WRITE_TIME);
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, displayLength, 2);
+  disp.setScanMode(scanMode);
+  disp.setBrightness(brightness);
+  disp.setRefreshMode(REFRESH_NONBLOCKING);
+  disp.setInt(displayLength == 4 ? 1234 : 123456);
+  disp.refresh();
+
+  byte expected[MAXDIGITS];
+  for (int i = 0; i < displayLength; i++)
+    expected[i] = disp.getDigit(i);
+
+  Sim::clearTransitions();
+  disp.resetStats();
+  unsigned long writes = Sim::pinWrites();
+  unsigned long start = micros();
+  double refreshTime = 0;
+  unsigned long calls = 0;
+  while (micros() - start < RUN_TIME)
+  {
+    Clock::time_point callStart = Clock::now();
+    disp.refresh();
+    refreshTime += std::chrono::duration<double, std::nano>(Clock::now() - callStart).count();
+    calls++;
+    Sim::advance(LOOP_TIME);
+  }
+  unsigned long end = micros();
+
+  SegmentStats stats = disp.getStats();
+  unsigned long frames = stats.frames > 0 ? stats.frames : 1;
+  GhostStats ghosts = findGhosts(expected, displayLength, true, start, end);
+
+  printf("%-28s %6.1f  ", name, stats.frameRate);
+  for (int i = 0; i < 6; i++)
+  {
+    if (i < displayLength)
+      printf(" %4.1f%%", digitOnTime(i, true, start, end) * 100.0 / (end - start));
+    else
+      printf("      ");
+  }
+  printf("  %5.1f %5.1f %5.1f  %5lu %4lu  %6.1f\n", (double)stats.pinWrites / frames, (double)(Sim::pinWrites() - writes) / frames,
+    (double)Sim::transitions().size() / frames, ghosts.windows, ghosts.time, refreshTime / calls);
+}
+
+// setInt and isNumberInRange before the formatting used integer math: every digit divided by pow() (float on an AVR)
+bool referenceInRange(int number, byte displayLength)
+{
+  return (-(pow(10, displayLength - 1) - 1)) <= number && number <= (pow(10, displayLength) - 1);
+}
+void referenceSetInt(SegmentControllerBase& disp, byte* bytes, int number, bool showLeadZeros)
+{
+  byte displayLength = disp.getDisplayLength();
+  if (!referenceInRange(number, displayLength))
+    return;
+
+  bool lead = !showLeadZeros;
+  bool negativ = number < 0;
+  if (negativ)
+    number *= -1;
+
+  for (int i = displayLength - 1; i >= 0 ; i--)
+  {
+    if (negativ && !lead && i == displayLength - 1)
+    {
+      bytes[i] = disp.getMinus();
+      negativ = false;
+      continue;
+    }
+
+    byte digit = (int)(number / pow(10, i)) % 10;
+    if (negativ && digit == 0 && i > 0)
+    {
+      byte d = (int)(number / pow(10, i - 1)) % 10;
+      if (d != 0)
+      {
+        bytes[i] = disp.getMinus();
+        negativ = false;
+      }
+    }
+    else if (lead && digit == 0)
+      bytes[i] = 0;
+    else
+    {
+      bytes[i] = disp.getNumber(digit);
+      lead = false;
+    }
+  }
+}
+
+void measureCalls()
+{
+  Sim::reset();
+  Sim::setTrace(false);
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_NONBLOCKING);
+
+  Clock::time_point start = Clock::now();
+  for (long i = 0; i < CALLS; i++)
+    disp.setInt(i % 10000);
+  printf("setInt                 %7.1f ns\n", nanoseconds(start, CALLS));
+
+  // the result is kept in a volatile byte, so the compiler can't leave the reference out
+  byte bytes[MAXDIGITS];
+  volatile byte sink = 0;
+  start = Clock::now();
+  for (long i = 0; i < CALLS; i++)
+  {
+    referenceSetInt(disp, bytes, i % 10000, false);
+    sink = sink + bytes[0];
+  }
+  printf("setInt with pow()      %7.1f ns\n", nanoseconds(start, CALLS));
+
+  start = Clock::now();
+  for (long i = 0; i < CALLS; i++)
+    sink = sink + disp.isNumberInRange(i % 20000 - 10000);
+  printf("isNumberInRange        %7.1f ns\n", nanoseconds(start, CALLS));
+
+  start = Clock::now();
+  for (long i = 0; i < CALLS; i++)
+    sink = sink + referenceInRange(i % 20000 - 10000, disp.getDisplayLength());
+  printf("isNumberInRange, pow() %7.1f ns\n", nanoseconds(start, CALLS));
+
+  start = Clock::now();
+  for (long i = 0; i < CALLS; i++)
+    disp.setString("HeLo");
+  printf("setString              %7.1f ns\n", nanoseconds(start, CALLS));
+
+  start = Clock::now();
+  for (long i = 0; i < CALLS; i++)
+    disp.setFloat(i % 1000 / 10.0, 1);
+  printf("setFloat               %7.1f ns\n", nanoseconds(start, CALLS));
+
+  // a new frame is translated for the pins on every call
+  start = Clock::now();
+  for (long i = 0; i < CALLS; i++)
+  {
+    disp.setInt(i % 10000);
+    disp.refresh();
+  }
+  printf("setInt + refresh       %7.1f ns\n", nanoseconds(start, CALLS));
+
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  start = Clock::now();
+  for (long i = 0; i < CALLS; i++)
+    disp.scan();
+  printf("scan (interrupt)       %7.1f ns\n", nanoseconds(start, CALLS));
+}
+
+// the output before the bytes were translated once per frame: every segment pin written bit by bit for every digit, and again to blank it
+class ReferenceOutput
+{
+  public:
+    ReferenceOutput(bool commonAnode, int segmentPins[8]) : _commonPinType(commonAnode ? 1 : 0), _segmentPins(segmentPins) { }
+
+    void showFrame(const byte bytes[], byte length, int digitPins[])
+    {
+      for (int i = 0; i < length; i++)
+      {
+        digitalWrite(digitPins[i], isCommonAnode() ? HIGH : LOW);
+        setSegments(bytes[i]);
+        digitalWrite(digitPins[i], isCommonAnode() ? LOW : HIGH);
+        setSegments(0);
+      }
+    }
+
+  private:
+    void setSegments(byte d)
+    {
+      byte pointer = 1;
+      for (int i = 0; i < getSegmentLength(); i++)
+      {
+        bool value = (d & pointer) != 0;
+        digitalWrite(_segmentPins[i], isCommonAnode() ? !value : value);
+        pointer *= 2;
+      }
+    }
+    int getSegmentLength() { return _segmentPins[7] > 0 ? 8 : 7; }
+    bool isCommonAnode() { return _commonPinType == 1; }
+
+    int _commonPinType;
+    int* _segmentPins;
+};
+
+void measureFrameOutput()
+{
+  // one frame of "1234" on 4 digits: host CPU time and digitalWrite calls
+  Sim::reset();
+  Sim::setTrace(false);
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  disp.setInt(1234);
+  disp.refresh();
+  byte bytes[4] = { disp.getDigit(0), disp.getDigit(1), disp.getDigit(2), disp.getDigit(3) };
+
+  ReferenceOutput reference(true, segmentPins);
+  unsigned long writes = Sim::pinWrites();
+  Clock::time_point start = Clock::now();
+  for (long i = 0; i < CALLS; i++)
+    reference.showFrame(bytes, 4, digitPins);
+  printf("frame, bit by bit (before)     %7.1f ns %5.1f writes\n", nanoseconds(start, CALLS), (double)(Sim::pinWrites() - writes) / CALLS);
+
+  // 5 slots per frame
+  writes = Sim::pinWrites();
+  start = Clock::now();
+  for (long i = 0; i < CALLS * 5; i++)
+    disp.scan();
+  printf("frame, translated              %7.1f ns %5.1f writes\n", nanoseconds(start, CALLS), (double)(Sim::pinWrites() - writes) / CALLS);
+
+  // a new frame every time: translated once, then scanned
+  writes = Sim::pinWrites();
+  start = Clock::now();
+  for (long i = 0; i < CALLS; i++)
+  {
+    disp.setInt(i % 2 == 0 ? 1234 : 5678);
+    disp.refresh();
+    for (int s = 0; s < 5; s++)
+      disp.scan();
+  }
+  printf("new frame, translated          %7.1f ns %5.1f writes\n", nanoseconds(start, CALLS), (double)(Sim::pinWrites() - writes) / CALLS);
+}
+
+// memory of the controllers and their parts, as built for the host (int and pointers are bigger than on an AVR, the README has the AVR sizes)
+void measureMemory()
+{
+  printf("sizeof SegmentDigit                            %4u bytes\n", (unsigned int)sizeof(SegmentDigit));
+  printf("sizeof SegmentGpioDriver                       %4u bytes\n", (unsigned int)sizeof(SegmentGpioDriver));
+  printf("sizeof StaticSegmentGpioDriver<true>           %4u bytes\n", (unsigned int)sizeof(StaticSegmentGpioDriver<true>));
+  printf("sizeof SegmentController (%d digits)            %4u bytes\n", MAXDIGITS, (unsigned int)sizeof(SegmentController));
+  printf("sizeof StaticSegmentController<4, true>        %4u bytes\n", (unsigned int)sizeof(StaticSegmentController<4, true>));
+  printf("sizeof SegmentDriverController (%d digits)      %4u bytes\n", MAXDIGITS, (unsigned int)sizeof(SegmentDriverController));
+}
+
+int main()
+{
+#ifdef SEGMENT_FAST_IO
+  printf("--- BENCHMARK (port registers) ---\n");
+#else
+  printf("--- BENCHMARK (digitalWrite) ---\n");
+#endif
+  printf("%-28s %6s   %-35s  %-17s  %-10s  %s\n", "", "fps", "duty D1-D6", "writes/frame", "ghost", "ns/refresh");
+  run("4 digits, digit scan", 4, SCAN_DIGITS, 255);
+  run("4 digits, segment scan", 4, SCAN_SEGMENTS, 255);
+  run("4 digits, digit scan, dim", 4, SCAN_DIGITS, 100);
+  run("4 digits, segment scan, dim", 4, SCAN_SEGMENTS, 100);
+  run("6 digits, digit scan", 6, SCAN_DIGITS, 255);
+  run("6 digits, segment scan", 6, SCAN_SEGMENTS, 255);
+  run("6 digits, auto", 6, SCAN_AUTO, 255);
+  printf("\n");
+  measureCalls();
+  printf("\n");
+  measureFrameOutput();
+  printf("\n");
+  measureMemory();
+  return 0;
+}
@@ -0,0 +1,108 @@
+/*
+  bind_test.cpp - Value binding: sampling, the moving average and the hysteresis around the value on the display.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+
+static volatile long boundValue = 0;
+
+// the number on the display (right aligned, a minus at the front)
+static long shownNumber(SegmentController& disp)
+{
+  long number = 0;
+  bool negative = false;
+  for (int i = 0; i < disp.getDisplayLength(); i++)
+  {
+    byte b = disp.getDigit(i);
+    if (b == disp.getMinus())
+      negative = true;
+    for (int n = 0; n < 10; n++)
+      if (b == disp.getNumber(n))
+        number = number * 10 + n;
+  }
+  return negative ? -number : number;
+}
+
+// a new value, shown after the next sample (refresh() samples it)
+static void sample(SegmentController& disp, long value)
+{
+  boundValue = value;
+  delay(10);
+  disp.refresh();
+}
+
+TEST(everyChangeIsShown)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  boundValue = 42;
+  disp.bindValue(&boundValue, 0, 10);
+  CHECK_EQUAL(42, shownNumber(disp));
+  sample(disp, -7);
+  CHECK_EQUAL(-7, shownNumber(disp));
+  CHECK(disp.isValueBound());
+}
+
+TEST(valueThatDoesNotFitKeepsTheHysteresis)
+{
+  // 10001 doesn't fit on 4 digits: 9990 stays, the next value is compared with 9990
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  boundValue = 9990;
+  disp.bindValue(&boundValue, 0, 10);
+  disp.setValueHysteresis(5);
+  sample(disp, 10001);
+  CHECK_EQUAL(9990, shownNumber(disp));
+  CHECK(disp.isValueBound());
+  sample(disp, 9997);
+  CHECK_EQUAL(9997, shownNumber(disp));
+  sample(disp, 9993);
+  CHECK_EQUAL(9997, shownNumber(disp));
+}
+
+TEST(firstValueThatDoesNotFit)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setValueHysteresis(5);
+  boundValue = 12345;
+  disp.bindValue(&boundValue, 0, 10);
+  sample(disp, 1234);
+  CHECK_EQUAL(1234, shownNumber(disp));
+}
+
+TEST(averagingIsExponential)
+{
+  // every sample moves the average by a quarter of the difference (rounded down)
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  boundValue = 0;
+  disp.bindValue(&boundValue, 0, 10);
+  disp.setValueAveraging(4);
+  const long expected[] = { 25, 43, 58, 68, 76 };
+  for (int i = 0; i < 5; i++)
+  {
+    sample(disp, 100);
+    CHECK_EQUAL(expected[i], shownNumber(disp));
+  }
+}
+
+TEST(averageSumFitsIntoALong)
+{
+  // 8 digits: at most 21 samples, 21 * 10^8 still fits into a 32 bit long
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 8, 2);
+  boundValue = 0;
+  disp.bindValue(&boundValue, 0, 10);
+  disp.setValueAveraging(255);
+  sample(disp, 1000000);
+  CHECK_EQUAL(1000000 / 21, shownNumber(disp));
+
+  // a sample far beyond the display counts as its limit (10^4): a quarter of it
+  SegmentController small = SegmentController(true, segmentPins, digitPins, 4, 2);
+  boundValue = 0;
+  small.bindValue(&boundValue, 0, 10);
+  small.setValueAveraging(4);
+  sample(small, 2147483647L);
+  CHECK_EQUAL(2500, shownNumber(small));
+  sample(small, -2147483647L);
+  CHECK_EQUAL(-625, shownNumber(small));
+}
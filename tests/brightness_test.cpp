@@ -0,0 +1,245 @@
+/*
+  brightness_test.cpp - Software brightness (binary code modulation): on-time ratios of dimmed digits under the tick and the timer driven scan, also of a SegmentScheduler.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "DonutStudioSegmentScheduler.h"
+#include "SegmentTest.h"
+
+static SegmentController* timerDisplay = NULL;
+
+static unsigned long timerScan()
+{
+  return timerDisplay->scan();
+}
+static SegmentScheduler* timerScheduler = NULL;
+
+static unsigned long timerSchedulerScan()
+{
+  return timerScheduler->scan();
+}
+
+// brightness of the digits from the left and the on-time in bit planes it gets (gamma corrected, of SEGMENT_BCM_LEVELS)
+static const byte brightness[4] = { 255, 184, 136, 64 };
+static const byte levels[4] = { 15, 8, 4, 1 };
+
+static void setUp(SegmentController& disp, byte scanMode)
+{
+  disp.setScanMode(scanMode);
+  disp.setInt(8888);
+  for (int i = 0; i < 4; i++)
+    disp.setDigitBrightness(i, brightness[i]);
+}
+
+// the segment a of every digit has to be lit level/15 of the time a full digit gets (a fifth of the digit scan, an eighth of the segment scan),
+// within a millisecond per second (the plane time is rounded down to whole microseconds)
+static void checkRatios(unsigned long start, unsigned long end, unsigned long slots, byte firstDigit = 0)
+{
+  unsigned long full = (end - start) / slots;
+  for (int i = 0; i < 4; i++)
+  {
+    unsigned long expected = full * levels[i] / SEGMENT_BCM_LEVELS;
+    CHECK_NEAR(expected, segmentOnTime(firstDigit + i, 0, true, start, end), 1000);
+  }
+}
+
+static void runLoop(SegmentController& disp, unsigned long time, unsigned long loopTime)
+{
+  unsigned long end = micros() + time;
+  while (micros() < end)
+  {
+    disp.refresh();
+    Sim::advance(loopTime);
+  }
+}
+
+TEST(nonblockingDigitScan)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_NONBLOCKING);
+  setUp(disp, SCAN_DIGITS);
+  disp.refresh();
+  disp.resetStats();
+  Sim::clearTransitions();
+
+  unsigned long start = micros();
+  runLoop(disp, 1000000, 10);
+  checkRatios(start, micros(), 5);
+  // the bit planes of a slot take the time of the slot: still 100 frames
+  CHECK_NEAR(100, disp.getStats().frames, 1);
+}
+
+TEST(nonblockingSegmentScan)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_NONBLOCKING);
+  setUp(disp, SCAN_SEGMENTS);
+  disp.refresh();
+  Sim::clearTransitions();
+
+  unsigned long start = micros();
+  runLoop(disp, 1000000, 10);
+  checkRatios(start, micros(), 8);
+}
+
+TEST(interruptDigitScan)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  timerDisplay = &disp;
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  setUp(disp, SCAN_DIGITS);
+  disp.refresh();
+  Sim::attachTimer(timerScan, 100);
+  delay(10);
+  Sim::clearTransitions();
+
+  // the timer is reloaded with the time of every bit plane, the loop only publishes frames
+  unsigned long start = micros();
+  for (int i = 0; i < 100; i++)
+  {
+    disp.refresh();
+    delay(10);
+  }
+  checkRatios(start, micros(), 5);
+}
+
+TEST(interruptSegmentScan)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  timerDisplay = &disp;
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  setUp(disp, SCAN_SEGMENTS);
+  disp.refresh();
+  Sim::attachTimer(timerScan, 100);
+  delay(16);
+  Sim::clearTransitions();
+
+  unsigned long start = micros();
+  delay(1000);
+  checkRatios(start, micros(), 8);
+}
+
+// two displays on the same segment pins (the second one on D5 - D8 of the test pins): 8 slots per frame,
+// different content on both, so a segment state one display leaves for the other shows up as a ghost
+static const int secondNumber = 2357;
+
+static void checkNoGhosts(SegmentController& disp1, SegmentController& disp2, unsigned long start, unsigned long end)
+{
+  byte expected[8];
+  for (int i = 0; i < 4; i++)
+  {
+    expected[i] = disp1.getDigit(i);
+    expected[4 + i] = disp2.getDigit(i);
+  }
+  CHECK(expected[0] != expected[4]);
+  CHECK_EQUAL(0, findGhosts(expected, 8, true, start, end).windows);
+}
+
+TEST(schedulerTick)
+{
+  SegmentController disp1 = SegmentController(true, segmentPins, digitPins, 4, 2);
+  SegmentController disp2 = SegmentController(true, segmentPins, digitPins + 4, 4, 2);
+  SegmentScheduler scheduler = SegmentScheduler(2);
+  scheduler.addDisplay(disp1);
+  scheduler.addDisplay(disp2);
+  setUp(disp1, SCAN_DIGITS);
+  disp2.setInt(secondNumber);
+  disp2.setBrightness(64);
+  for (int i = 0; i < 10000; i++)
+  {
+    scheduler.refresh();
+    Sim::advance(10);
+  }
+  Sim::clearTransitions();
+
+  unsigned long start = micros();
+  unsigned long end = start + 1000000;
+  while (micros() < end)
+  {
+    scheduler.refresh();
+    Sim::advance(10);
+  }
+  checkRatios(start, micros(), 8);
+  for (int i = 0; i < 4; i++)
+    CHECK_NEAR(1000000 / 8 / SEGMENT_BCM_LEVELS, segmentOnTime(4 + i, 0, true, start, micros()), 1000);
+
+  // digitalWrite as slow as on an AVR: the states between the writes count, both displays with glyphs that differ from digit to digit
+  disp1.setInt(1468);
+  Sim::setWriteTime(4);
+  Sim::clearTransitions();
+  start = micros();
+  end = start + 100000;
+  while (micros() < end)
+  {
+    scheduler.refresh();
+    Sim::advance(10);
+  }
+  checkNoGhosts(disp1, disp2, start, micros());
+}
+
+TEST(schedulerInterrupt)
+{
+  SegmentController disp1 = SegmentController(true, segmentPins, digitPins, 4, 2);
+  SegmentController disp2 = SegmentController(true, segmentPins, digitPins + 4, 4, 2);
+  SegmentScheduler scheduler = SegmentScheduler(2);
+  timerScheduler = &scheduler;
+  scheduler.addDisplay(disp1);
+  scheduler.addDisplay(disp2);
+  setUp(disp1, SCAN_DIGITS);
+  disp2.setInt(secondNumber);
+  scheduler.update();
+  Sim::attachTimer(timerSchedulerScan, 100);
+  delay(100);
+  Sim::clearTransitions();
+
+  unsigned long start = micros();
+  for (int i = 0; i < 100; i++)
+  {
+    scheduler.update();
+    delay(10);
+  }
+  checkRatios(start, micros(), 8);
+  for (int i = 0; i < 4; i++)
+    CHECK_NEAR(1000000 / 8, segmentOnTime(4 + i, 0, true, start, micros()), 1000);
+
+  disp1.setInt(1468);
+  Sim::setWriteTime(4);
+  Sim::clearTransitions();
+  start = micros();
+  for (int i = 0; i < 10; i++)
+  {
+    scheduler.update();
+    delay(10);
+  }
+  checkNoGhosts(disp1, disp2, start, micros());
+}
+
+TEST(onTimeFollowsTheGammaCurve)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  timerDisplay = &disp;
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  disp.setInt(8888);
+  Sim::attachTimer(timerScan, 100);
+
+  // every brightness step lights at least as long as the one below, everything above 0 stays visible
+  unsigned long previous = 0;
+  for (int b = 0; b < 256; b += 8)
+  {
+    disp.setBrightness(b);
+    disp.refresh();
+    delay(20);
+    Sim::clearTransitions();
+    unsigned long start = micros();
+    delay(100);
+    unsigned long onTime = segmentOnTime(0, 0, true, start, micros());
+    CHECK(onTime >= previous);
+    if (b > 0)
+      CHECK(onTime > 0);
+    else
+      CHECK_EQUAL(0, onTime);
+    previous = onTime;
+  }
+}
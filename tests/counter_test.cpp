@@ -0,0 +1,178 @@
+/*
+  counter_test.cpp - SegmentCounter and SegmentClock carry like an odometer and only write the digits that changed.
+  Created by Donut Studio, October 17, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "DonutStudioSegmentCounter.h"
+#include "SegmentTest.h"
+
+// a byte the counters never write: a digit still showing it after a step wasn't written
+static const byte marker = 0b10000000;
+
+static void setMarker(SegmentControllerBase& disp)
+{
+  for (int i = 0; i < disp.getDisplayLength(); i++)
+    disp.setDigit(i, marker);
+}
+
+// the digits after a step, from the left: the text the step has to show (' ' for a blank digit) and the digits it wrote (bit 0 = left-most digit)
+static void checkStep(SegmentControllerBase& disp, const char* before, const char* text, byte written)
+{
+  bool passed = true;
+  byte length = disp.getDisplayLength();
+  for (int i = 0; i < length; i++)
+  {
+    bool wasWritten = disp.getDigit(i) != marker;
+    byte expected = text[i] == ' ' ? disp.getNumber(-1) : disp.getNumber(text[i] - '0');
+    passed = passed && wasWritten == (((written >> i) & 1) != 0);
+    if (wasWritten)
+      passed = passed && disp.getDigit(i) == expected;
+  }
+  if (!passed)
+    printf("  %s -> \"%s\", expected writes 0x%02x\n", before, text, written);
+  CHECK(passed);
+}
+
+#define CHECK_COUNTER_STEP(counter, start, step, text, written) \
+  do { counter.set(start); setMarker(disp); counter.step; checkStep(disp, #start " " #step, text, written); } while (0)
+
+TEST(counterCarriesLikeAnOdometer)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  SegmentCounter counter = SegmentCounter(disp);
+
+  CHECK_COUNTER_STEP(counter, 1234, increment(), "1235", 0b1000);
+  CHECK_COUNTER_STEP(counter, 1299, increment(), "1300", 0b1110);
+  CHECK_COUNTER_STEP(counter, 1300, decrement(), "1299", 0b1110);
+  CHECK_COUNTER_STEP(counter, 5000, add(-1234), "3766", 0b1111);
+  CHECK_COUNTER_STEP(counter, 4321, add(10), "4331", 0b0100);
+  CHECK_COUNTER_STEP(counter, 4321, add(0), "4321", 0b0000);
+
+  // a new digit in front and a lead zero that goes blank
+  CHECK_COUNTER_STEP(counter, 99, increment(), " 100", 0b1110);
+  CHECK_COUNTER_STEP(counter, 100, decrement(), "  99", 0b1110);
+  CHECK_COUNTER_STEP(counter, 1000, decrement(), " 999", 0b1111);
+  CHECK_COUNTER_STEP(counter, 10, add(-10), "   0", 0b0100);
+
+  // wraps around, the digits that don't fit are left out
+  CHECK_COUNTER_STEP(counter, 9999, increment(), "   0", 0b1111);
+  CHECK_COUNTER_STEP(counter, 0, decrement(), "9999", 0b1111);
+  CHECK_COUNTER_STEP(counter, 9998, add(5), "   3", 0b1111);
+  CHECK_COUNTER_STEP(counter, 2, add(-5), "9997", 0b1111);
+  CHECK_COUNTER_STEP(counter, 0, add(123456), "3456", 0b1111);
+  counter.set(123456);
+  CHECK_EQUAL(3456, counter.get());
+  counter.add(-3457);
+  CHECK_EQUAL(9999, counter.get());
+}
+
+TEST(counterWithLeadZeros)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  SegmentCounter counter = SegmentCounter(disp, true);
+
+  CHECK_COUNTER_STEP(counter, 99, increment(), "0100", 0b1110);
+  CHECK_COUNTER_STEP(counter, 100, decrement(), "0099", 0b1110);
+  CHECK_COUNTER_STEP(counter, 9999, increment(), "0000", 0b1111);
+  CHECK_COUNTER_STEP(counter, 7, increment(), "0008", 0b1000);
+}
+
+TEST(everyStepOfOneOnlyWritesTheChangedDigits)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 6, 2);
+  SegmentCounter counter = SegmentCounter(disp);
+
+  // 0 -> 999999 -> 0: every step writes the digits from the right up to the carry, plus the one that changes between blank and a decimal
+  for (long value = 0; value < 1000000; value += 37)
+  {
+    counter.set(value);
+    setMarker(disp);
+    counter.increment();
+
+    long next = (value + 1) % 1000000;
+    int changed = 0;
+    for (long a = value, b = next; a != b; a /= 10, b /= 10)
+      changed++;
+    int written = 0;
+    for (int i = 0; i < 6; i++)
+      written += disp.getDigit(i) != marker;
+    CHECK_EQUAL(changed, written);
+    CHECK_EQUAL(next, counter.get());
+  }
+}
+
+#define CHECK_CLOCK_STEP(clock, hours, minutes, seconds, step, text, written) \
+  do { clock.setTime(hours, minutes, seconds); setMarker(disp); clock.step; checkStep(disp, #hours ":" #minutes ":" #seconds " " #step, text, written); } while (0)
+
+TEST(clockHoursMinutes)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  SegmentClock clock = SegmentClock(disp, CLOCK_HOURS_MINUTES);
+
+  CHECK_CLOCK_STEP(clock, 12, 34, 0, tickMinute(), "1235", 0b1000);
+  CHECK_CLOCK_STEP(clock, 12, 59, 0, tickMinute(), "1300", 0b1110);
+  CHECK_CLOCK_STEP(clock, 9, 59, 0, tickMinute(), "1000", 0b1111);
+  CHECK_CLOCK_STEP(clock, 19, 59, 0, tickMinute(), "2000", 0b1111);
+  CHECK_CLOCK_STEP(clock, 23, 59, 0, tickMinute(), "0000", 0b1111);
+  CHECK_CLOCK_STEP(clock, 23, 9, 0, tickMinute(), "2310", 0b1100);
+
+  // the seconds are counted but not shown
+  CHECK_CLOCK_STEP(clock, 12, 34, 30, tickSecond(), "1234", 0b0000);
+  CHECK_CLOCK_STEP(clock, 23, 59, 59, tickSecond(), "0000", 0b1111);
+  CHECK_EQUAL(0, clock.getSeconds());
+
+  // a whole day of minutes and of seconds
+  clock.setTime(0, 0, 0);
+  for (long i = 0; i < 24L * 60; i++)
+  {
+    CHECK_EQUAL(i / 60, clock.getHours());
+    CHECK_EQUAL(i % 60, clock.getMinutes());
+    clock.tickMinute();
+  }
+  CHECK_EQUAL(0, clock.getHours());
+  CHECK_EQUAL(0, clock.getMinutes());
+  for (long i = 0; i < 24L * 60 * 60; i++)
+    clock.tickSecond();
+  CHECK_EQUAL(0, clock.getHours() + clock.getMinutes() + clock.getSeconds());
+}
+
+TEST(clockMinutesSeconds)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  SegmentClock clock = SegmentClock(disp, CLOCK_MINUTES_SECONDS);
+
+  CHECK_CLOCK_STEP(clock, 0, 12, 34, tickSecond(), "1235", 0b1000);
+  CHECK_CLOCK_STEP(clock, 0, 19, 59, tickSecond(), "2000", 0b1111);
+  CHECK_CLOCK_STEP(clock, 0, 30, 10, tickMinute(), "3110", 0b0010);
+
+  // 59:59 rolls into the hidden hours
+  CHECK_CLOCK_STEP(clock, 5, 59, 59, tickSecond(), "0000", 0b1111);
+  CHECK_EQUAL(6, clock.getHours());
+  CHECK_CLOCK_STEP(clock, 23, 59, 59, tickSecond(), "0000", 0b1111);
+  CHECK_EQUAL(0, clock.getHours());
+}
+
+TEST(clockWithoutLeadZeroAndColon)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  SegmentClock clock = SegmentClock(disp, CLOCK_HOURS_MINUTES, false);
+
+  CHECK_CLOCK_STEP(clock, 9, 59, 0, tickMinute(), "1000", 0b1111);
+  CHECK_CLOCK_STEP(clock, 23, 59, 0, tickMinute(), " 000", 0b1111);
+  clock.setTime(9, 15);
+  CHECK_EQUAL(disp.getNumber(-1), disp.getDigit(0));
+
+  // the colon is an overlay on the dp of the second digit, the digits aren't written
+  setMarker(disp);
+  clock.setColonBlinking(true);
+  clock.setColon(true);
+  clock.tickSecond();
+  CHECK(!clock.getColon());
+  CHECK_EQUAL(0, disp.getOverlay(1));
+  clock.tickSecond();
+  CHECK_EQUAL(disp.getDot(), disp.getOverlay(1));
+  for (int i = 0; i < 4; i++)
+    CHECK_EQUAL(marker, disp.getDigit(i));
+}
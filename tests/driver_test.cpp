@@ -0,0 +1,196 @@
+/*
+  driver_test.cpp - Bus traffic of the 74HC595 and MAX7219 drivers, decoded from the pin trace.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+
+#define DATA_PIN 20
+#define CLOCK_PIN 21
+#define LATCH_PIN 22
+
+// the 16 bits clocked in before every rising edge of the latch/load pin (the first bit ends up in the highest bit),
+// edges without bits clocked in (e.g. the load pin going high in begin()) don't latch a word
+static std::vector<unsigned int> decodeBus()
+{
+  std::vector<unsigned int> words;
+  uint8_t data = Sim::startLevel(DATA_PIN);
+  unsigned int shifted = 0;
+  int bits = 0;
+  for (size_t i = 0; i < Sim::transitions().size(); i++)
+  {
+    const Sim::Transition& t = Sim::transitions()[i];
+    if (t.pin == DATA_PIN)
+      data = t.level;
+    else if (t.pin == CLOCK_PIN && t.level == HIGH)
+    {
+      shifted = (shifted << 1 | data) & 0xFFFF;
+      bits++;
+    }
+    else if (t.pin == LATCH_PIN && t.level == HIGH && bits > 0)
+    {
+      words.push_back(shifted);
+      bits = 0;
+    }
+  }
+  return words;
+}
+
+// 74HC595: the digit register (shifted first, Q0 = D1) in the high byte, the segment register (Q0 = a) in the low byte
+static unsigned int registerWord(byte digits, byte segments)
+{
+  return digits << 8 | segments;
+}
+
+TEST(shiftRegisterDigitScan)
+{
+  SegmentShiftRegisterDriver driver = SegmentShiftRegisterDriver(true, DATA_PIN, CLOCK_PIN, LATCH_PIN);
+  SegmentDriverController disp = SegmentDriverController(driver, 4, 2);
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  disp.setInt(1234);
+  disp.refresh();
+
+  Sim::clearTransitions();
+  for (int i = 0; i < 5; i++)
+    disp.scan();
+  std::vector<unsigned int> words = decodeBus();
+
+  // from the right-most digit: every lit digit gets its own segments (common anode: segments low), then the dark slot
+  std::vector<unsigned int> lit;
+  for (size_t i = 0; i < words.size(); i++)
+    if ((words[i] >> 8) != 0)
+      lit.push_back(words[i]);
+  CHECK_EQUAL(4, lit.size());
+  for (size_t i = 0; i < lit.size() && i < 4; i++)
+    CHECK_EQUAL(registerWord(1 << (3 - i), (byte)~disp.getDigit(3 - i)), lit[i]);
+  CHECK(words.size() > 0 && words.back() == registerWord(0, 0xFF));
+}
+
+TEST(shiftRegisterSegmentScan)
+{
+  SegmentShiftRegisterDriver driver = SegmentShiftRegisterDriver(false, DATA_PIN, CLOCK_PIN, LATCH_PIN);
+  SegmentDriverController disp = SegmentDriverController(driver, 4, 2);
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  disp.setScanMode(SCAN_SEGMENTS);
+  disp.setInt(1234);
+  disp.refresh();
+
+  Sim::clearTransitions();
+  for (int i = 0; i < 8; i++)
+    disp.scan();
+  std::vector<unsigned int> words = decodeBus();
+
+  // common cathode: the digits with the segment low, the segment high, one segment at a time
+  byte expected[8];
+  for (int s = 0; s < 8; s++)
+  {
+    byte digits = 0;
+    for (int d = 0; d < 4; d++)
+      if (disp.getDigit(d) & (1 << s))
+        digits |= 1 << d;
+    expected[s] = digits;
+  }
+  int seen = 0;
+  for (size_t i = 0; i < words.size(); i++)
+  {
+    byte digits = ~(words[i] >> 8);
+    byte segments = words[i] & 0xFF;
+    if (digits == 0 || segments == 0)
+      continue;
+    CHECK_EQUAL(0, segments & (segments - 1));
+    int s = 0;
+    while (!(segments & (1 << s)))
+      s++;
+    CHECK_EQUAL(expected[s], digits);
+    seen |= 1 << s;
+  }
+  // every segment used by 1234 was lit once (the dp isn't)
+  int used = 0;
+  for (int s = 0; s < 8; s++)
+    if (expected[s] != 0)
+      used |= 1 << s;
+  CHECK_EQUAL(used, seen);
+}
+
+TEST(shiftRegisterSendsOnlyChanges)
+{
+  SegmentShiftRegisterDriver driver = SegmentShiftRegisterDriver(true, DATA_PIN, CLOCK_PIN, LATCH_PIN);
+  SegmentDriverController disp = SegmentDriverController(driver, 4, 2);
+  Sim::clearTransitions();
+
+  // begin() blanked the display already
+  driver.hideDigit(0);
+  driver.hideDigit(1);
+  CHECK_EQUAL(0, decodeBus().size());
+  CHECK_EQUAL(0, Sim::transitions().size());
+}
+
+// MAX7219: the address in the high byte, the value in the low byte
+static unsigned int maxWord(byte address, byte value)
+{
+  return address << 8 | value;
+}
+// no-decode bits: dp, a, b, c, d, e, f, g (bit 7 to 0)
+static byte maxSegments(byte b)
+{
+  byte value = b & 0b10000000;
+  for (int s = 0; s < 7; s++)
+    if (b & (1 << s))
+      value |= 0b01000000 >> s;
+  return value;
+}
+
+TEST(max7219Setup)
+{
+  SegmentMax7219Driver driver = SegmentMax7219Driver(DATA_PIN, CLOCK_PIN, LATCH_PIN);
+  SegmentDriverController disp = SegmentDriverController(driver, 4, 2);
+  std::vector<unsigned int> words = decodeBus();
+
+  // display test off, no decoding, scan limit 4 digits, intensity, blank digits, shutdown off
+  unsigned int expected[] = { maxWord(0x0F, 0), maxWord(0x09, 0), maxWord(0x0B, 3), maxWord(0x0A, 0x0F),
+    maxWord(1, 0), maxWord(2, 0), maxWord(3, 0), maxWord(4, 0), maxWord(0x0C, 1) };
+  CHECK(words.size() >= 9);
+  for (size_t i = 0; i < 9 && i < words.size(); i++)
+    CHECK_EQUAL(expected[i], words[i]);
+}
+
+TEST(max7219SendsOnlyChangedDigits)
+{
+  SegmentMax7219Driver driver = SegmentMax7219Driver(DATA_PIN, CLOCK_PIN, LATCH_PIN);
+  SegmentDriverController disp = SegmentDriverController(driver, 4, 2);
+
+  Sim::clearTransitions();
+  disp.setInt(1234);
+  disp.refresh();
+  std::vector<unsigned int> words = decodeBus();
+  // from the right-most digit, DIG0 (register 1) is D1
+  CHECK_EQUAL(4, words.size());
+  for (size_t i = 0; i < words.size() && i < 4; i++)
+    CHECK_EQUAL(maxWord(4 - i, maxSegments(disp.getDigit(3 - i))), words[i]);
+
+  // the chip scans on its own: refreshing the same frame sends nothing
+  Sim::clearTransitions();
+  for (int i = 0; i < 100; i++)
+    disp.refresh();
+  CHECK_EQUAL(0, Sim::transitions().size());
+
+  // one changed digit, one register
+  Sim::clearTransitions();
+  disp.setInt(1239);
+  disp.refresh();
+  words = decodeBus();
+  CHECK_EQUAL(1, words.size());
+  CHECK(words.size() == 1 && words[0] == maxWord(4, maxSegments(disp.getNumber(9))));
+}
+
+TEST(max7219Brightness)
+{
+  SegmentMax7219Driver driver = SegmentMax7219Driver(DATA_PIN, CLOCK_PIN, LATCH_PIN);
+  SegmentDriverController disp = SegmentDriverController(driver, 4, 2);
+  Sim::clearTransitions();
+  disp.setBrightness(128);
+  std::vector<unsigned int> words = decodeBus();
+  CHECK(words.size() >= 1 && words.back() == maxWord(0x0A, 128 >> 4));
+}
@@ -0,0 +1,141 @@
+/*
+  effects_test.cpp - Blinking, inverted, fading and chasing digits: the effects act on the digit they were set on (counted from the left) and show in the scan.
+  Created by Donut Studio, October 17, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+
+static SegmentController* timerDisplay = NULL;
+
+static unsigned long timerScan()
+{
+  return timerDisplay->scan();
+}
+
+// the timer driven scan from now on, frames of 10 ms
+static void startTimer(SegmentController& disp)
+{
+  timerDisplay = &disp;
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  disp.refresh();
+  Sim::attachTimer(timerScan, 100);
+}
+
+// the time (in microseconds) a digit was lit between two times in milliseconds
+static unsigned long litTime(byte digitIndex, unsigned long from, unsigned long to)
+{
+  if (micros() < to * 1000)
+    Sim::advance(to * 1000 - micros());
+  return digitOnTime(digitIndex, true, from * 1000, to * 1000);
+}
+
+TEST(blinkingActsOnTheLeftMostDigit)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setInt(8888);
+  disp.setBlinking(0, true);
+  CHECK(disp.getBlinking(0));
+  CHECK(!disp.getBlinking(3));
+  startTimer(disp);
+
+  // on in the first half of every interval, off in the second one (the phase is read once per 10 ms frame)
+  CHECK(litTime(0, 510, 740) > 0);
+  CHECK_EQUAL(0, litTime(0, 760, 990));
+  CHECK(litTime(3, 760, 990) > 0);
+  // a fifth of the time for the others, half of it for the blinking one
+  CHECK_NEAR(200000, litTime(1, 1000, 2000), 2000);
+  CHECK_NEAR(100000, litTime(0, 1000, 2000), 11000);
+
+  disp.setBlinkingAll(false);
+  disp.setDigitState(0, false);
+  disp.refresh();
+  CHECK_EQUAL(0, litTime(0, 2020, 3000));
+  CHECK(litTime(3, 2020, 3000) > 0);
+}
+
+TEST(invertedDigitsKeepTheirDp)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setInt(1111);
+  disp.setDigitSegment(1, 7, true);
+  disp.setInverted(1, true);
+  CHECK(disp.getInverted(1));
+  CHECK(!disp.getInverted(2));
+  startTimer(disp);
+  litTime(0, 0, 100);
+
+  // the content stays, the shown segments are swapped
+  byte one = disp.getNumber(1);
+  CHECK_EQUAL(one | disp.getDot(), disp.getDigit(1));
+  byte expected[4] = { one, (byte)((one ^ 0b01111111) | disp.getDot()), one, one };
+  for (int d = 0; d < 4; d++)
+    for (int s = 0; s < 8; s++)
+      CHECK_EQUAL((expected[d] >> s) & 1, segmentOnTime(d, s, true, 20000, 100000) > 0);
+
+  disp.setInvertedAll(true);
+  CHECK(disp.getInverted(3));
+  disp.setInvertedAll(false);
+  CHECK(!disp.getInverted(1));
+}
+
+TEST(fadingGoesDownAndUpAgain)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setInt(8888);
+  disp.setFading(0, true);
+  CHECK(disp.getFading(0));
+  startTimer(disp);
+
+  // down in the first interval (250 ms), up in the second one
+  unsigned long previous = litTime(0, 500, 550);
+  for (unsigned long t = 550; t < 750; t += 50)
+  {
+    unsigned long time = litTime(0, t, t + 50);
+    CHECK(time < previous);
+    previous = time;
+  }
+  // the windows around the turn are mirrored
+  previous = litTime(0, 750, 800);
+  for (unsigned long t = 800; t < 1000; t += 50)
+  {
+    unsigned long time = litTime(0, t, t + 50);
+    CHECK(time > previous);
+    previous = time;
+  }
+  // on average about half the on-time of a full digit, the others stay full
+  CHECK_NEAR(100000, litTime(0, 1000, 2000), 15000);
+  CHECK_NEAR(200000, litTime(3, 1000, 2000), 2000);
+}
+
+TEST(chasingRunsFromLeftToRight)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setInt(8888);
+  disp.setBlinkInterval(100);
+  disp.setChasingAll(true);
+  CHECK(disp.getChasing(2));
+  startTimer(disp);
+
+  // one digit per interval, starting with the left-most one
+  for (unsigned long step = 4; step < 12; step++)
+    for (int d = 0; d < 4; d++)
+    {
+      unsigned long time = litTime(d, step * 100 + 10, step * 100 + 90);
+      CHECK_EQUAL(d == (int)(step % 4), time > 0);
+    }
+
+  // only the chasing digits take turns, the others stay
+  disp.setChasingAll(false);
+  disp.setChasing(1, true);
+  disp.setChasing(3, true);
+  CHECK(!disp.getChasing(0));
+  for (unsigned long step = 14; step < 18; step++)
+  {
+    CHECK(litTime(0, step * 100 + 10, step * 100 + 90) > 0);
+    CHECK(litTime(2, step * 100 + 10, step * 100 + 90) > 0);
+    CHECK_EQUAL(step % 2 == 0, litTime(1, step * 100 + 10, step * 100 + 90) > 0);
+    CHECK_EQUAL(step % 2 == 1, litTime(3, step * 100 + 10, step * 100 + 90) > 0);
+  }
+}
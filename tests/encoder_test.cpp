@@ -0,0 +1,40 @@
+/*
+  encoder_test.cpp - The compile-time text encoder (segmentText) gives the same bytes as getCharacter.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+
+// evaluated by the compiler: a text that doesn't encode like the font doesn't build
+static_assert(segmentText("8.").bytes[0] == 0b01111111 && segmentText("8.").bytes[1] == 0b10000000, "segmentText encodes digits and the dot");
+static_assert(segmentText("Hi").bytes[0] == segmentText("hI").bytes[0], "segmentText ignores the case");
+static_assert(sizeof(segmentText("Hey!")) == 4, "segmentText has no terminating byte");
+
+static const SegmentText<4> hey PROGMEM = segmentText("Hey!");
+
+TEST(everyCharacterLikeGetCharacter)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  for (int c = 0; c < 256; c++)
+  {
+    if (SegmentFont::character((char)c) != disp.getCharacter((char)c))
+      printf("  character %d: 0x%02x, getCharacter 0x%02x\n", c, SegmentFont::character((char)c), disp.getCharacter((char)c));
+    CHECK_EQUAL(disp.getCharacter((char)c), SegmentFont::character((char)c));
+  }
+}
+
+TEST(textFromFlashLikeSetString)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setString("Hey!");
+  byte expected[4];
+  for (int i = 0; i < 4; i++)
+    expected[i] = disp.getDigit(i);
+
+  disp.clear();
+  disp.setByte_P(hey.bytes);
+  for (int i = 0; i < 4; i++)
+    CHECK_EQUAL(expected[i], disp.getDigit(i));
+}
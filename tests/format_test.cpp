@@ -0,0 +1,273 @@
+/*
+  format_test.cpp - Integer number formatting (setInt, setUnsigned, setHex, setBinary, setNumber) against printf.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+#include <limits.h>
+
+// values around every power of ten and two, the limits of long and pseudo-random ones
+static long values[200];
+static int valueCount = 0;
+
+static void collectValues()
+{
+  valueCount = 0;
+  long power = 1;
+  for (int i = 0; i < 10; i++, power *= 10)
+  {
+    values[valueCount++] = power - 1;
+    values[valueCount++] = power;
+    values[valueCount++] = -(power - 1);
+    values[valueCount++] = -power;
+  }
+  for (int i = 0; i < 31; i += 3)
+    values[valueCount++] = 1L << i;
+  values[valueCount++] = LONG_MAX;
+  values[valueCount++] = LONG_MIN;
+  unsigned long random = 12345;
+  while (valueCount < 200)
+  {
+    random = random * 1103515245UL + 12345UL;
+    long value = (long)(random % 2000000UL) - 1000000L;
+    values[valueCount++] = value / (long)(random % 997 + 1);
+  }
+}
+
+// the digits after a set function, from the left: a text of the glyphs, ' ' for a blank digit
+static void readDisplay(SegmentControllerBase& disp, char* text)
+{
+  byte length = disp.getDisplayLength();
+  for (int i = 0; i < length; i++)
+  {
+    text[i] = '?';
+    const char* characters = " 0123456789abcdef-";
+    for (const char* c = characters; *c != '\0'; c++)
+      if (disp.getCharacter(*c) == disp.getDigit(i))
+        text[i] = *c;
+  }
+  text[length] = '\0';
+}
+
+// the text printf makes of the number, right or left aligned on the display, or "unchanged" if it doesn't fit
+static void expectText(char* text, byte length, const char* number, bool alignLeft)
+{
+  int size = strlen(number);
+  if (size > length)
+  {
+    strcpy(text, "unchanged");
+    return;
+  }
+  for (int i = 0; i < length; i++)
+    text[i] = ' ';
+  memcpy(alignLeft ? text : text + length - size, number, size);
+  text[length] = '\0';
+}
+
+static void binaryText(char* text, unsigned long number, int minDigits)
+{
+  char digits[40];
+  int count = 0;
+  do
+  {
+    digits[count++] = '0' + (number & 1);
+    number >>= 1;
+  }
+  while (number > 0);
+  while (count < minDigits)
+    digits[count++] = '0';
+  for (int i = 0; i < count; i++)
+    text[i] = digits[count - 1 - i];
+  text[count] = '\0';
+}
+
+// set a marker first, a number that doesn't fit leaves it on the display
+static void checkText(SegmentControllerBase& disp, const char* expected, long value, const char* function)
+{
+  char shown[MAXDIGITS + 1];
+  readDisplay(disp, shown);
+  bool unchanged = strcmp(expected, "unchanged") == 0;
+  bool passed = unchanged ? disp.getDigit(0) == disp.getCharacter('?') : strcmp(shown, expected) == 0;
+  if (!passed)
+    printf("  %s(%ld): \"%s\", expected \"%s\"\n", function, value, shown, expected);
+  CHECK(passed);
+}
+
+static void setMarker(SegmentControllerBase& disp)
+{
+  for (int i = 0; i < disp.getDisplayLength(); i++)
+    disp.setDigit(i, disp.getCharacter('?'));
+}
+
+static void checkAllFormats(SegmentControllerBase& disp)
+{
+  collectValues();
+  byte length = disp.getDisplayLength();
+  char number[40];
+  char expected[40];
+
+  for (int v = 0; v < valueCount; v++)
+  {
+    long value = values[v];
+    unsigned long unsignedValue = (unsigned long)value;
+
+    snprintf(number, sizeof(number), "%ld", value);
+    expectText(expected, length, number, false);
+    setMarker(disp);
+    disp.setInt(value);
+    checkText(disp, expected, value, "setInt");
+
+    // the minus takes the place of a lead zero
+    snprintf(number, sizeof(number), "%0*ld", (int)length, value);
+    expectText(expected, length, number, false);
+    setMarker(disp);
+    disp.setInt(value, true);
+    checkText(disp, expected, value, "setInt lead zeros");
+
+    snprintf(number, sizeof(number), "%ld", value);
+    expectText(expected, length, number, true);
+    setMarker(disp);
+    disp.setNumber(value, DEC, false, true);
+    checkText(disp, expected, value, "setNumber left");
+
+    snprintf(number, sizeof(number), "%lu", unsignedValue);
+    expectText(expected, length, number, false);
+    setMarker(disp);
+    disp.setUnsigned(unsignedValue);
+    checkText(disp, expected, value, "setUnsigned");
+
+    snprintf(number, sizeof(number), "%lx", unsignedValue);
+    expectText(expected, length, number, false);
+    setMarker(disp);
+    disp.setHex(unsignedValue);
+    checkText(disp, expected, value, "setHex");
+
+    snprintf(number, sizeof(number), "%0*lx", (int)length, unsignedValue);
+    expectText(expected, length, number, false);
+    setMarker(disp);
+    disp.setHex(unsignedValue, true);
+    checkText(disp, expected, value, "setHex lead zeros");
+
+    binaryText(number, unsignedValue, 1);
+    expectText(expected, length, number, false);
+    setMarker(disp);
+    disp.setBinary(unsignedValue);
+    checkText(disp, expected, value, "setBinary");
+
+    binaryText(number, unsignedValue, length);
+    expectText(expected, length, number, false);
+    setMarker(disp);
+    disp.setBinary(unsignedValue, true);
+    checkText(disp, expected, value, "setBinary lead zeros");
+
+    // the range of setInt: as many digits as the display has, a negative number one less
+    long long limit = 1;
+    for (int i = 0; i < length; i++)
+      limit *= 10;
+    bool inRange = -(limit / 10 - 1) <= value && value <= limit - 1;
+    CHECK_EQUAL(inRange, disp.isNumberInRange(value));
+  }
+}
+
+TEST(fourDigits)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  checkAllFormats(disp);
+}
+
+TEST(sixDigits)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 6, 2);
+  checkAllFormats(disp);
+}
+
+TEST(oneDigit)
+{
+  StaticSegmentController<1, false> disp(segmentPins, digitPins, 2);
+  checkAllFormats(disp);
+}
+
+TEST(otherBases)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  char shown[5];
+  disp.setNumber(-7, 8);
+  readDisplay(disp, shown);
+  CHECK(strcmp(shown, "  -7") == 0);
+  disp.setNumber(255, 16, true, false);
+  readDisplay(disp, shown);
+  CHECK(strcmp(shown, "00ff") == 0);
+
+  // bases outside 2-16 leave the display
+  disp.setNumber(10, 17);
+  readDisplay(disp, shown);
+  CHECK(strcmp(shown, "00ff") == 0);
+}
+
+// the expected digits from the left, a '.' goes onto the digit before, "unchanged" if the marker has to stay
+static void checkFixed(SegmentControllerBase& disp, const char* expected, const char* call)
+{
+  bool passed = true;
+  if (strcmp(expected, "unchanged") == 0)
+  {
+    for (int i = 0; i < disp.getDisplayLength(); i++)
+      passed = passed && disp.getDigit(i) == disp.getCharacter('?');
+  }
+  else
+  {
+    byte bytes[MAXDIGITS] = { 0 };
+    int count = 0;
+    for (const char* c = expected; *c != '\0'; c++)
+    {
+      if (*c == '.')
+        bytes[count - 1] |= disp.getDot();
+      else
+        bytes[count++] = disp.getCharacter(*c);
+    }
+    passed = count == disp.getDisplayLength();
+    for (int i = 0; i < count; i++)
+      passed = passed && disp.getDigit(i) == bytes[i];
+  }
+  if (!passed)
+    printf("  %s: expected \"%s\"\n", call, expected);
+  CHECK(passed);
+}
+
+#define CHECK_FIXED(disp, call, expected) \
+  do { setMarker(disp); disp.call; checkFixed(disp, expected, #call); } while (0)
+
+TEST(floatsAndFixedPoint)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 6, 2);
+  CHECK_FIXED(disp, setFloat(3.14159f), "   3.14");
+  CHECK_FIXED(disp, setFloat(-2.5f, 3), " -2.500");
+  CHECK_FIXED(disp, setFloat(0.05f), "   0.05");
+  CHECK_FIXED(disp, setFloat(-0.004f, 2), "   0.00");
+  CHECK_FIXED(disp, setFloat(999.996f, 2), "1000.00");
+
+  // decimals are dropped (rounded) until the number fits
+  CHECK_FIXED(disp, setFloat(12345.67f), "12345.7");
+  CHECK_FIXED(disp, setFloat(-1234.56f), "-1234.6");
+  CHECK_FIXED(disp, setFloat(3.14159f, 9), "3.14159");
+  // scaled by 10^4 these are far beyond a 32 bit long
+  CHECK_FIXED(disp, setFloat(123456.0f, 4), "123456");
+  CHECK_FIXED(disp, setFloat(-99999.0f, 5), "-99999");
+  CHECK_FIXED(disp, setFloat(1234567.0f), "unchanged");
+  CHECK_FIXED(disp, setFloat(-100000.0f), "unchanged");
+
+  CHECK_FIXED(disp, setFixed(1234, 2), "  12.34");
+  CHECK_FIXED(disp, setFixed(5, 2), "   0.05");
+  CHECK_FIXED(disp, setFixed(-5, 3), " -0.005");
+  CHECK_FIXED(disp, setFixed(123456, 5), "1.23456");
+  CHECK_FIXED(disp, setFixed(1234567, 2), "unchanged");
+  CHECK_FIXED(disp, setFixed(-12345, 1), "-1234.5");
+  CHECK_FIXED(disp, setFixed(-123456, 1), "unchanged");
+  CHECK_FIXED(disp, setFixed(12, 6), "unchanged");
+
+  SegmentController eight = SegmentController(true, segmentPins, digitPins, 8, 2);
+  CHECK_FIXED(eight, setFloat(12345678.0f), "12345678");
+  CHECK_FIXED(eight, setFloat(-1234567.0f, 7), "-1234567");
+  CHECK_FIXED(eight, setFloat(0.125f, 3), "    0.125");
+}
@@ -0,0 +1,136 @@
+/*
+  interrupt_test.cpp - REFRESH_INTERRUPT: the simulated timer runs scan(), frames are swapped whole and never torn.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+
+static SegmentController* timerDisplay = NULL;
+
+// the timer interrupt of the sketches, reloaded with the time scan() returns
+static unsigned long timerScan()
+{
+  return timerDisplay->scan();
+}
+
+// frames seen by the interrupt: every digit has to show the same glyph within a frame (the dark slot ends a frame)
+static byte frameGlyph = 0;
+static bool frameTorn = false;
+static unsigned long checkedFrames = 0;
+static unsigned long tornFrames = 0;
+
+static unsigned long checkedScan()
+{
+  unsigned long time = timerDisplay->scan();
+  unsigned int lit = litDigits(true, 4);
+  if (lit == 0)
+  {
+    if (frameGlyph != 0)
+      checkedFrames++;
+    if (frameTorn)
+      tornFrames++;
+    frameGlyph = 0;
+    frameTorn = false;
+  }
+  else if (frameGlyph == 0)
+    frameGlyph = litSegments(true);
+  else if (litSegments(true) != frameGlyph)
+    frameTorn = true;
+  return time;
+}
+
+TEST(timerDrivesTheScan)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  timerDisplay = &disp;
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  disp.setInt(1234);
+  disp.refresh();
+  Sim::attachTimer(timerScan, 100);
+  Sim::clearTransitions();
+
+  // the loop only publishes new frames, a long delay doesn't stop the scan
+  unsigned long start = micros();
+  for (int i = 0; i < 10; i++)
+  {
+    disp.refresh();
+    delay(100);
+  }
+  unsigned long end = micros();
+
+  for (int i = 0; i < 4; i++)
+  {
+    CHECK_NEAR(200000, digitOnTime(i, true, start, end), 2000);
+    CHECK_NEAR(100, digitOnEdges(i, true, start, end), 1);
+  }
+  // 5 slots per frame, the timer is reloaded with the slot time
+  CHECK_NEAR(500, Sim::timerCalls(), 1);
+}
+
+TEST(refreshDoesNotTouchThePins)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  unsigned long writes = Sim::pinWrites();
+  for (int i = 0; i < 100; i++)
+  {
+    disp.setInt(i);
+    disp.refresh();
+    disp.clear();
+  }
+  CHECK_EQUAL(writes, Sim::pinWrites());
+}
+
+TEST(newFramesWaitForTheScanToStartOver)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  disp.setInt(1111);
+  disp.refresh();
+
+  // D4 (first slot) and D3 lit with the old frame, the new one only shows after the dark slot
+  disp.scan();
+  disp.scan();
+  disp.setInt(7777);
+  disp.refresh();
+  disp.scan();
+  CHECK_EQUAL(disp.getNumber(1), litSegments(true));
+  disp.scan();
+  CHECK_EQUAL(disp.getNumber(1), litSegments(true));
+  disp.scan();
+  CHECK_EQUAL(0, litDigits(true, 4));
+  disp.scan();
+  CHECK_EQUAL(disp.getNumber(7), litSegments(true));
+}
+
+TEST(framesNeverTear)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 1);
+  timerDisplay = &disp;
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  frameGlyph = 0;
+  frameTorn = false;
+  checkedFrames = 0;
+  tornFrames = 0;
+
+  // the interrupt also runs inside every call into the core (in the middle of the set functions and refresh()),
+  // the loop writes numbers with the same digit everywhere while the time moves in small steps
+  Sim::attachTimer(checkedScan, 10);
+  Sim::setPreemption(true);
+  for (long i = 0; i < 20000; i++)
+  {
+    disp.setInt((i % 9 + 1) * 1111);
+    if (i % 3 == 0)
+      disp.setDigit(i % 4, disp.getNumber((i + 1) % 9 + 1));
+    if (i % 3 == 0)
+      disp.setDigit(i % 4, disp.getNumber(i % 9 + 1));
+    disp.refresh();
+    Sim::advance(i % 7 * 100);
+  }
+  Sim::setPreemption(false);
+
+  CHECK(checkedFrames > 1000);
+  CHECK_EQUAL(0, tornFrames);
+}
@@ -0,0 +1,135 @@
+/*
+  layer_test.cpp - Overlay and mask: kept by every set function, print() and the scroller, and setting the same layer again doesn't publish a frame.
+  Created by Donut Studio, October 17, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+
+// the bytes the scan shows, from the left: two frames after refresh() published the display
+static void readShown(SegmentController& disp, byte shown[4])
+{
+  disp.refresh();
+  for (int i = 0; i < 10; i++)
+  {
+    disp.scan();
+    unsigned int lit = litDigits(true, 4);
+    for (int d = 0; d < 4; d++)
+      if (lit == (1u << d))
+        shown[d] = litSegments(true);
+  }
+}
+
+// the text with a dp on the second digit and without the segment g on the last one
+static void checkLayers(SegmentController& disp, const char* text)
+{
+  byte shown[4] = { 0, 0, 0, 0 };
+  readShown(disp, shown);
+  bool same = true;
+  for (int d = 0; d < 4; d++)
+  {
+    byte expected = disp.getCharacter(text[d]);
+    if (d == 1)
+      expected |= disp.getDot();
+    if (d == 3)
+      expected &= ~0b01000000;
+    same = same && shown[d] == expected;
+  }
+  if (!same)
+    printf("  expected \"%s\" with the layers\n", text);
+  CHECK(same);
+}
+
+TEST(layersStayOnTop)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  disp.setOverlaySegment(1, 7, true);
+  disp.setMaskSegment(3, 6, true);
+  CHECK_EQUAL(disp.getDot(), disp.getOverlay(1));
+  CHECK_EQUAL(0b01000000, disp.getMask(3));
+
+  disp.setInt(1234);
+  checkLayers(disp, "1234");
+  // the content stays without the layers
+  CHECK_EQUAL(disp.getNumber(2), disp.getDigit(1));
+  CHECK_EQUAL(disp.getNumber(4), disp.getDigit(3));
+
+  disp.setString("AbC8");
+  checkLayers(disp, "AbC8");
+  disp.println(-56);
+  checkLayers(disp, "-56 ");
+  disp.clear();
+  checkLayers(disp, "    ");
+
+  // the scroller writes the content of every step
+  disp.setScrollerUpdateTime(100);
+  disp.setScroller("8888");
+  for (int i = 0; i < 4; i++)
+  {
+    delay(101);
+    disp.refresh();
+  }
+  checkLayers(disp, "8888");
+
+  // without the layers again
+  disp.clearOverlay();
+  disp.clearMask();
+  byte shown[4];
+  readShown(disp, shown);
+  for (int d = 0; d < 4; d++)
+    CHECK_EQUAL(disp.getCharacter('8'), shown[d]);
+}
+
+// counts the bytes translated: every published frame translates all digits
+class CountingDriver : public SegmentShiftRegisterDriver
+{
+  public:
+    CountingDriver() : SegmentShiftRegisterDriver(true, 20, 21, 22) { }
+    void translate(byte b, SegmentPinState& state)
+    {
+      translations++;
+      SegmentShiftRegisterDriver::translate(b, state);
+    }
+    unsigned long translations = 0;
+};
+
+// the digits translated by refresh()
+static unsigned long published(SegmentDriverController& disp, CountingDriver& driver)
+{
+  unsigned long before = driver.translations;
+  disp.refresh();
+  return driver.translations - before;
+}
+
+TEST(sameLayerDoesNotPublish)
+{
+  CountingDriver driver;
+  SegmentDriverController disp = SegmentDriverController(driver, 4, 2);
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  disp.setInt(1234);
+  CHECK_EQUAL(4, published(disp, driver));
+  CHECK_EQUAL(0, published(disp, driver));
+
+  // a heartbeat set in every loop only publishes when it changes
+  disp.setOverlay(1, disp.getDot());
+  CHECK_EQUAL(4, published(disp, driver));
+  for (int i = 0; i < 10; i++)
+  {
+    disp.setOverlay(1, disp.getDot());
+    disp.setOverlaySegment(1, 7, true);
+    disp.setMask(2, 0);
+    disp.setMaskSegment(3, 6, false);
+    CHECK_EQUAL(0, published(disp, driver));
+  }
+
+  disp.setMaskSegment(3, 6, true);
+  CHECK_EQUAL(4, published(disp, driver));
+  disp.clearOverlay();
+  disp.clearMask();
+  CHECK_EQUAL(4, published(disp, driver));
+  disp.clearOverlay();
+  disp.clearMask();
+  CHECK_EQUAL(0, published(disp, driver));
+}
@@ -0,0 +1,104 @@
+/*
+  limit_test.cpp - setSegmentLimit() never lights more LEDs at once and still shows every segment, setSegmentEqualization() scales the on-time by the lit segments.
+  Created by Donut Studio, October 17, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+
+static SegmentController* timerDisplay = NULL;
+
+static unsigned long timerScan()
+{
+  return timerDisplay->scan();
+}
+
+// digits with 8, 5, 2 and 1 lit segments
+static byte glyphs[4] = { 0b11111111, 0b01101101, 0b00000110, 0b10000000 };
+
+// a second of the timer driven scan, with digitalWrite as slow as on an AVR (the states between the writes count too)
+static void runTimer(SegmentController& disp, unsigned long& start, unsigned long& end)
+{
+  timerDisplay = &disp;
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  disp.refresh();
+  Sim::setWriteTime(4);
+  Sim::attachTimer(timerScan, 100);
+  delay(20);
+  Sim::clearTransitions();
+  start = micros();
+  delay(1000);
+  end = micros();
+}
+
+static void checkLimit(byte scanMode, byte limit)
+{
+  Sim::reset();
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setScanMode(scanMode);
+  disp.setSegmentLimit(limit);
+  disp.setByte(glyphs);
+  unsigned long start, end;
+  runTimer(disp, start, end);
+
+  CHECK(maxLitLeds(4, true, start, end) <= limit);
+  // the parts of a slot together light the whole glyph, nothing else
+  for (int d = 0; d < 4; d++)
+    for (int s = 0; s < 8; s++)
+    {
+      bool lit = segmentOnTime(d, s, true, start, end) > 0;
+      CHECK_EQUAL((glyphs[d] >> s) & 1, lit);
+    }
+  CHECK_EQUAL(0, findGhosts(glyphs, 4, true, start, end).windows);
+}
+
+TEST(limitInTheDigitScan)
+{
+  for (byte limit = 1; limit <= 8; limit++)
+    checkLimit(SCAN_DIGITS, limit);
+}
+
+TEST(limitInTheSegmentScan)
+{
+  for (byte limit = 1; limit <= 4; limit++)
+    checkLimit(SCAN_SEGMENTS, limit);
+}
+
+TEST(withoutLimit)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setInt(8888);
+  disp.setDigitSegment(0, 7, true);
+  unsigned long start, end;
+  runTimer(disp, start, end);
+  CHECK_EQUAL(8, maxLitLeds(4, true, start, end));
+}
+
+// the on-time of a segment: lit segments / the most lit segments of a visible digit, in bit planes rounded up (8: 15, 5: 10, 2: 4, 1: 2 of 15)
+TEST(equalizedOnTimesFollowTheLitSegments)
+{
+  const byte levels[4] = { 15, 10, 4, 2 };
+  const byte segments[4] = { 0, 0, 1, 7 };
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setSegmentEqualization(true);
+  disp.setByte(glyphs);
+  unsigned long start, end;
+  runTimer(disp, start, end);
+
+  // a fifth of the time is a full digit of the digit scan
+  unsigned long full = (end - start) / 5;
+  for (int d = 0; d < 4; d++)
+    CHECK_NEAR(full * levels[d] / SEGMENT_BCM_LEVELS, segmentOnTime(d, segments[d], true, start, end), 2000);
+
+  // the segment scan lights every segment line on its own, nothing to equalize
+  Sim::reset();
+  SegmentController segmentScan = SegmentController(true, segmentPins, digitPins, 4, 2);
+  segmentScan.setScanMode(SCAN_SEGMENTS);
+  segmentScan.setSegmentEqualization(true);
+  segmentScan.setByte(glyphs);
+  runTimer(segmentScan, start, end);
+  full = (end - start) / 8;
+  for (int d = 0; d < 4; d++)
+    CHECK_NEAR(full, segmentOnTime(d, segments[d], true, start, end), 2000);
+}
@@ -0,0 +1,102 @@
+/*
+  nonblocking_test.cpp - REFRESH_NONBLOCKING: refresh() never waits, lights at most one digit and keeps the slot timing.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+
+// run the loop for a time (in microseconds): refresh(), then the rest of the loop takes loopTime, returns the time spent in refresh()
+static unsigned long runLoop(SegmentController& disp, unsigned long time, unsigned long loopTime, bool checkDigits = false)
+{
+  unsigned long inside = 0;
+  unsigned long end = micros() + time;
+  while (micros() < end)
+  {
+    unsigned long start = micros();
+    disp.refresh();
+    inside += micros() - start;
+    if (checkDigits)
+    {
+      unsigned int lit = litDigits(true, 4);
+      CHECK((lit & (lit - 1)) == 0);
+    }
+    Sim::advance(loopTime);
+  }
+  return inside;
+}
+
+TEST(blockingRefreshWaitsForEveryDigit)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setInt(1234);
+  unsigned long start = micros();
+  disp.refresh();
+  // 4 digits and the dark slot, 2 ms each
+  CHECK_EQUAL(10000, micros() - start);
+}
+
+TEST(refreshNeverWaits)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_NONBLOCKING);
+  disp.setInt(1234);
+
+  // also with a digitalWrite as slow as on an AVR the loop keeps almost all of its time
+  CHECK_EQUAL(0, runLoop(disp, 1000000, 50));
+  Sim::setWriteTime(4);
+  unsigned long inside = runLoop(disp, 1000000, 50);
+  CHECK(inside < 1000000 / 100);
+}
+
+TEST(refreshLightsAtMostOneDigit)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_NONBLOCKING);
+  disp.setInt(8888);
+  runLoop(disp, 100000, 37, true);
+}
+
+TEST(everyDigitGetsItsSlot)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_NONBLOCKING);
+  disp.setInt(1234);
+  disp.refresh();
+  Sim::clearTransitions();
+
+  unsigned long start = micros();
+  runLoop(disp, 1000000, 50);
+  unsigned long end = micros();
+
+  // 5 slots of 2 ms: 100 frames per second, every digit lit 1/5 of the time (off by at most one loop per slot)
+  for (int i = 0; i < 4; i++)
+  {
+    CHECK_NEAR(200000, digitOnTime(i, true, start, end), 100 * 50);
+    CHECK_NEAR(100, digitOnEdges(i, true, start, end), 1);
+  }
+  byte expected[4] = { disp.getDigit(0), disp.getDigit(1), disp.getDigit(2), disp.getDigit(3) };
+  CHECK_EQUAL(0, findGhosts(expected, 4, true, start, end).windows);
+}
+
+TEST(lateCallsSkipPhasesInsteadOfCatchingUp)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_NONBLOCKING);
+  disp.setInt(1234);
+  disp.resetStats();
+
+  // a loop of 5 ms: every call moves on by one digit, never several at once
+  for (int i = 0; i < 100; i++)
+  {
+    unsigned long writes = Sim::pinWrites();
+    disp.refresh();
+    // the lit digit off, at most 8 segments, the next digit on
+    CHECK(Sim::pinWrites() - writes <= 10);
+    Sim::advance(5000);
+  }
+  SegmentStats stats = disp.getStats();
+  CHECK(stats.missedDeadlines >= 99);
+  CHECK_EQUAL(20, stats.frames);
+}
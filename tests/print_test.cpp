@@ -0,0 +1,148 @@
+/*
+  print_test.cpp - print(), println() and printf() write glyphs straight into the digits, without any heap allocation.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+
+// the display has to show the same bytes as setString with the text
+static void checkShows(SegmentController& disp, const char* text)
+{
+  SegmentController expected = SegmentController(true, segmentPins, digitPins, 4, 2);
+  expected.setString(text);
+  bool same = true;
+  for (int i = 0; i < 4; i++)
+    same = same && disp.getDigit(i) == expected.getDigit(i);
+  if (!same)
+    printf("  expected \"%s\"\n", text);
+  CHECK(same);
+}
+
+TEST(printShowsLikeSetString)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.println(1234);
+  checkShows(disp, "1234");
+  disp.println(-12);
+  checkShows(disp, "-12 ");
+  disp.println(0xBEEF, HEX);
+  checkShows(disp, "BEEF");
+  disp.println(F("Hi"));
+  checkShows(disp, "Hi  ");
+}
+
+// a dot isn't a digit of its own (like in setString), it goes onto the digit before
+static void checkDots(SegmentController& disp, const char* text, byte dots)
+{
+  for (int i = 0; i < 4; i++)
+  {
+    byte expected = disp.getCharacter(text[i]) | (((dots >> i) & 1) ? disp.getDot() : 0);
+    CHECK_EQUAL(expected, disp.getDigit(i));
+  }
+}
+
+TEST(dotsGoOntoTheDigitBefore)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.println(3.14159, 3);
+  checkDots(disp, "3142", 0b0001);
+  disp.printf("%d.%02d\n", 12, 5);
+  checkDots(disp, "1205", 0b0010);
+
+  // a second dot gets a digit of its own
+  disp.println("1..2");
+  checkDots(disp, "1 2 ", 0b0011);
+}
+
+TEST(printsAppendUntilNewLine)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.print('a');
+  disp.print(1);
+  checkShows(disp, "a1  ");
+  disp.print("b");
+  checkShows(disp, "a1b ");
+  disp.println();
+  disp.print(7);
+  checkShows(disp, "7   ");
+
+  disp.setCursor(2);
+  disp.print("42");
+  checkShows(disp, "7 42");
+  CHECK_EQUAL(4, disp.getCursor());
+}
+
+// a cut off line could be read as another value: every digit shows a minus instead, until the next line
+TEST(tooLongLineShowsMinus)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  CHECK_EQUAL(4, disp.print(1234));
+  // the dropped characters are taken, print() doesn't stop before the line end
+  CHECK_EQUAL(1, disp.write('5'));
+  checkShows(disp, "----");
+  disp.println(12345);
+  checkShows(disp, "----");
+  disp.print(F("abcd"));
+  checkShows(disp, "abcd");
+
+  // the next line, setCursor and clear start over
+  disp.println("e");
+  checkShows(disp, "----");
+  disp.println(-1.5, 1);
+  checkDots(disp, "-15 ", 0b0010);
+  disp.print(F("abcde"));
+  disp.setCursor(1);
+  disp.print(7);
+  checkShows(disp, "-7--");
+  disp.print("89");
+  disp.clear();
+  disp.print(42);
+  checkShows(disp, "42  ");
+
+  // the line end in the same buffer as the overflow
+  disp.println();
+  disp.printf("%d\n", 12345);
+  checkShows(disp, "----");
+  disp.printf("%d\n", 12);
+  checkShows(disp, "12  ");
+  disp.print(F("12345\n"));
+  disp.print(7);
+  checkShows(disp, "7   ");
+  // also when the text is longer than the buffer of printf
+  disp.println();
+  disp.printf("%s\n", "123456789012345678901234567890");
+  checkShows(disp, "----");
+  disp.printf("%d\n", 3);
+  checkShows(disp, "3   ");
+
+  // a dot still goes onto the last digit
+  disp.println();
+  disp.println(123.4, 1);
+  checkDots(disp, "1234", 0b0100);
+  disp.printf("%d.\n", 1234);
+  checkDots(disp, "1234", 0b1000);
+}
+
+TEST(printNeverAllocates)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  unsigned long allocations = Sim::allocations();
+  for (int i = 0; i < 1000; i++)
+  {
+    disp.println(i);
+    disp.println(i / 10.0, 1);
+    disp.println(i, HEX);
+    disp.println(F("AbC"));
+    disp.printf("%3d\n", i);
+    disp.refresh();
+  }
+  CHECK_EQUAL(0, Sim::allocations() - allocations);
+
+  // the String path allocates, the counter sees it
+  String text("1234");
+  disp.setString(text);
+  CHECK(Sim::allocations() - allocations > 0);
+}
@@ -0,0 +1,100 @@
+/*
+  scan_test.cpp - On-time of every segment with the digit scan and the segment scan, and the strategy SCAN_AUTO picks.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+
+struct ScanResult
+{
+  // on-time (in microseconds) of every segment of every digit (from the left) during one second, frames shown
+  unsigned long onTime[8][8];
+  unsigned long frames;
+};
+
+// a second of REFRESH_NONBLOCKING with a loop of 50 microseconds, every digit showing 8.
+static ScanResult runScan(byte displayLength, byte scanMode)
+{
+  Sim::reset();
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, displayLength, 2);
+  disp.setRefreshMode(REFRESH_NONBLOCKING);
+  disp.setScanMode(scanMode);
+  for (int i = 0; i < displayLength; i++)
+    disp.setDigit(i, disp.getNumber(8) | disp.getDot());
+  disp.refresh();
+  disp.resetStats();
+  Sim::clearTransitions();
+
+  unsigned long start = micros();
+  while (micros() - start < 1000000UL)
+  {
+    disp.refresh();
+    Sim::advance(50);
+  }
+  unsigned long end = micros();
+
+  ScanResult result;
+  for (int d = 0; d < displayLength; d++)
+    for (int s = 0; s < 8; s++)
+      result.onTime[d][s] = segmentOnTime(d, s, true, start, end);
+  result.frames = disp.getStats().frames;
+  return result;
+}
+
+static void checkOnTime(const ScanResult& result, byte displayLength, unsigned long expected)
+{
+  for (int d = 0; d < displayLength; d++)
+    for (int s = 0; s < 8; s++)
+      CHECK_NEAR(expected, result.onTime[d][s], 2000);
+}
+
+TEST(digitScanLightsEverySegmentForItsDigitSlot)
+{
+  // 4 digits and the dark slot: every segment is lit 1/5 of the time, 100 frames
+  ScanResult result = runScan(4, SCAN_DIGITS);
+  checkOnTime(result, 4, 1000000UL / 5);
+  CHECK_NEAR(100, result.frames, 1);
+
+  // 6 digits: 1/7
+  result = runScan(6, SCAN_DIGITS);
+  checkOnTime(result, 6, 1000000UL / 7);
+}
+
+TEST(segmentScanLightsEverySegmentForItsSegmentSlot)
+{
+  // 8 segment lines, no matter how many digits: every segment is lit 1/8 of the time, 62.5 frames
+  ScanResult result = runScan(4, SCAN_SEGMENTS);
+  checkOnTime(result, 4, 1000000UL / 8);
+  CHECK_NEAR(62.5, result.frames, 1);
+
+  result = runScan(8, SCAN_SEGMENTS);
+  checkOnTime(result, 8, 1000000UL / 8);
+}
+
+TEST(autoPicksTheLongerOnTime)
+{
+  for (int length = 1; length <= 8; length++)
+  {
+    ScanResult digits = runScan(length, SCAN_DIGITS);
+    ScanResult segments = runScan(length, SCAN_SEGMENTS);
+    ScanResult automatic = runScan(length, SCAN_AUTO);
+
+    // the strategy with the longer on-time also shows more frames (7 digits: both have 8 slots), auto has the on-time of the better one
+    bool segmentsLonger = segments.onTime[0][0] > digits.onTime[0][0] + 2000;
+    CHECK_EQUAL(segmentsLonger, segments.frames > digits.frames + 1);
+    unsigned long longest = segments.onTime[0][0] > digits.onTime[0][0] ? segments.onTime[0][0] : digits.onTime[0][0];
+    unsigned long mostFrames = segments.frames > digits.frames ? segments.frames : digits.frames;
+    CHECK(automatic.onTime[0][0] + 2000 >= longest);
+    CHECK(automatic.frames + 1 >= mostFrames);
+  }
+
+  // from 8 digits on, the segment scan wins: 1/8 instead of 1/9
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 8, 2);
+  disp.setScanMode(SCAN_AUTO);
+  CHECK(disp.isScanningSegments());
+  SegmentController small = SegmentController(true, segmentPins, digitPins, 6, 2);
+  small.setScanMode(SCAN_AUTO);
+  CHECK(!small.isScanningSegments());
+}
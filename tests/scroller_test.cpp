@@ -0,0 +1,185 @@
+/*
+  scroller_test.cpp - The scroller on a ring buffer: appending while it scrolls, the space left, streams that drop what left the display and texts read in place.
+  Created by Donut Studio, October 17, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+
+// the display has to show the glyphs of the text, from the left
+static void checkShows(SegmentController& disp, const char* text)
+{
+  bool same = true;
+  for (int i = 0; i < 4; i++)
+    same = same && disp.getDigit(i) == disp.getCharacter(text[i]);
+  if (!same)
+    printf("  expected \"%s\"\n", text);
+  CHECK(same);
+}
+
+// one step of the scroller: refresh() after the update time (the interrupt mode doesn't wait in refresh())
+static void step(SegmentController& disp, const char* text)
+{
+  delay(disp.getScrollerUpdateTime() + 1);
+  disp.refresh();
+  checkShows(disp, text);
+}
+
+static SegmentController createDisplay()
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  disp.setScrollerUpdateTime(100);
+  return disp;
+}
+
+TEST(appendWhileScrolling)
+{
+  SegmentController disp = createDisplay();
+  disp.setScroller("ab");
+  step(disp, "   a");
+  CHECK_EQUAL(2, disp.appendScroller("cd"));
+  step(disp, "  ab");
+  step(disp, " abc");
+  step(disp, "abcd");
+  step(disp, "bcd ");
+  step(disp, "cd  ");
+
+  // the end of the text entered the display already: the gap stays blank, appended bytes enter on the right
+  CHECK_EQUAL(1, disp.appendScroller("e"));
+  CHECK_EQUAL(7, disp.getScrollerLength());
+  step(disp, "d  e");
+  step(disp, "  e ");
+
+  // a repeating text starts over once it left the display
+  step(disp, " e  ");
+  step(disp, "e   ");
+  step(disp, "    ");
+  step(disp, "    ");
+  step(disp, "   a");
+}
+
+TEST(spaceAndFullBuffer)
+{
+  SegmentController disp = createDisplay();
+  CHECK_EQUAL(MAXSCROLLERSIZE, disp.getScrollerSpace());
+  disp.setScroller("0123456789");
+  CHECK_EQUAL(MAXSCROLLERSIZE - 10, disp.getScrollerSpace());
+
+  byte bytes[MAXSCROLLERSIZE];
+  for (int i = 0; i < MAXSCROLLERSIZE; i++)
+    bytes[i] = disp.getNumber(i % 10);
+  CHECK_EQUAL(MAXSCROLLERSIZE - 12, disp.appendScroller(bytes, MAXSCROLLERSIZE - 12));
+  CHECK_EQUAL(2, disp.getScrollerSpace());
+
+  // only what fits is taken, the rest has to be sent again later
+  CHECK_EQUAL(2, disp.appendScroller("abc"));
+  CHECK_EQUAL(0, disp.getScrollerSpace());
+  CHECK_EQUAL(0, disp.appendScroller("d"));
+  CHECK_EQUAL(0, disp.appendScroller(bytes, 1));
+  CHECK_EQUAL(MAXSCROLLERSIZE, disp.getScrollerLength());
+  CHECK_EQUAL(disp.getCharacter('b'), disp.getScrollElement(MAXSCROLLERSIZE - 1));
+
+  // a repeating text never frees its space
+  step(disp, "   0");
+  step(disp, "  01");
+  for (int i = 0; i < 100; i++)
+  {
+    delay(disp.getScrollerUpdateTime() + 1);
+    disp.refresh();
+  }
+  CHECK_EQUAL(0, disp.getScrollerSpace());
+}
+
+TEST(streamDropsWhatLeftTheDisplay)
+{
+  SegmentController disp = createDisplay();
+  disp.setScrollerLoop(false);
+  CHECK_EQUAL(6, disp.appendScroller("abcdef"));
+  step(disp, "   a");
+  step(disp, "  ab");
+  step(disp, " abc");
+  step(disp, "abcd");
+  CHECK_EQUAL(MAXSCROLLERSIZE - 6, disp.getScrollerSpace());
+
+  // every step drops the element that left on the left and frees its space
+  step(disp, "bcde");
+  CHECK_EQUAL(MAXSCROLLERSIZE - 5, disp.getScrollerSpace());
+  step(disp, "cdef");
+  step(disp, "def ");
+  step(disp, "ef  ");
+  CHECK_EQUAL(2, disp.getScrollerLength());
+  step(disp, "f   ");
+  step(disp, "    ");
+  CHECK_EQUAL(0, disp.getScrollerLength());
+  CHECK_EQUAL(MAXSCROLLERSIZE, disp.getScrollerSpace());
+
+  // empty: the stream waits with a blank display, new bytes enter on the right
+  step(disp, "    ");
+  step(disp, "    ");
+  disp.appendScroller("xy");
+  step(disp, "   x");
+  step(disp, "  xy");
+
+  // an endless stream: appended as fast as it scrolls, it never runs out of space
+  for (int i = 0; i < 3 * MAXSCROLLERSIZE; i++)
+  {
+    CHECK_EQUAL(1, disp.appendScroller("z"));
+    delay(disp.getScrollerUpdateTime() + 1);
+    disp.refresh();
+  }
+  CHECK(disp.getScrollerLength() <= 6);
+}
+
+TEST(streamDropsFromATextReadInPlace)
+{
+  SegmentController disp = createDisplay();
+  disp.setScrollerLoop(false);
+  disp.setScroller(F("abcde"));
+  CHECK_EQUAL(MAXSCROLLERSIZE, disp.getScrollerSpace());
+  step(disp, "   a");
+  step(disp, "  ab");
+  step(disp, " abc");
+  step(disp, "abcd");
+  step(disp, "bcde");
+  CHECK_EQUAL(4, disp.getScrollerLength());
+  CHECK_EQUAL(disp.getCharacter('b'), disp.getScrollElement(0));
+  disp.appendScroller("f");
+  step(disp, "cdef");
+}
+
+TEST(scrollElementOfATextReadInPlace)
+{
+  SegmentController disp = createDisplay();
+  char text[] = "abc";
+  disp.setScrollerSource(text);
+  disp.appendScroller("de");
+
+  // an appended byte is changed in the ring buffer, the text stays where it is
+  disp.setScrollElement(4, disp.getCharacter('x'));
+  text[2] = 'q';
+  CHECK_EQUAL(disp.getCharacter('q'), disp.getScrollElement(2));
+
+  // an element of the text: the text is copied in front of the appended bytes first
+  disp.setScrollElement(0, disp.getCharacter('y'));
+  text[1] = 'r';
+  const char* expected = "ybqdx";
+  CHECK_EQUAL(5, disp.getScrollerLength());
+  for (int i = 0; i < 5; i++)
+    CHECK_EQUAL(disp.getCharacter(expected[i]), disp.getScrollElement(i));
+  CHECK_EQUAL(MAXSCROLLERSIZE - 5, disp.getScrollerSpace());
+
+  // the shown digits follow the change
+  step(disp, "   y");
+  step(disp, "  yb");
+
+  // a text longer than the buffer can't be copied, the element stays
+  char longText[MAXSCROLLERSIZE + 2];
+  memset(longText, 'a', sizeof(longText) - 1);
+  longText[sizeof(longText) - 1] = '\0';
+  disp.setScrollerSource(longText);
+  disp.setScrollElement(0, disp.getCharacter('y'));
+  CHECK_EQUAL(disp.getCharacter('a'), disp.getScrollElement(0));
+  CHECK_EQUAL(MAXSCROLLERSIZE + 1, disp.getScrollerLength());
+}
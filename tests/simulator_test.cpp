@@ -0,0 +1,112 @@
+/*
+  simulator_test.cpp - Checks of the stand-in core the other tests rely on: clock, timer, pin trace and allocation counter.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "SegmentTest.h"
+
+static unsigned long timerTimes[8];
+static int timerIndex = 0;
+
+// called after 100, 200, 300, ... microseconds
+static unsigned long growingTimer()
+{
+  if (timerIndex < 8)
+    timerTimes[timerIndex] = micros();
+  timerIndex++;
+  return 100 * (timerIndex + 1);
+}
+
+TEST(clockMovesOnlyWithDelay)
+{
+  CHECK_EQUAL(0, micros());
+  delay(3);
+  CHECK_EQUAL(3000, micros());
+  CHECK_EQUAL(3, millis());
+  delayMicroseconds(250);
+  Sim::advance(750);
+  CHECK_EQUAL(4000, micros());
+  CHECK_EQUAL(4, millis());
+}
+
+TEST(timerReloadsFromReturnedTime)
+{
+  timerIndex = 0;
+  Sim::attachTimer(growingTimer, 100);
+  Sim::advance(1000);
+  // 100, 100 + 200, 300 + 300, 600 + 400
+  CHECK_EQUAL(4, Sim::timerCalls());
+  CHECK_EQUAL(100, timerTimes[0]);
+  CHECK_EQUAL(300, timerTimes[1]);
+  CHECK_EQUAL(600, timerTimes[2]);
+  CHECK_EQUAL(1000, timerTimes[3]);
+}
+
+TEST(timerWaitsForInterrupts)
+{
+  timerIndex = 0;
+  Sim::attachTimer(growingTimer, 100, 100);
+  noInterrupts();
+  Sim::advance(150);
+  CHECK_EQUAL(0, Sim::timerCalls());
+  interrupts();
+  CHECK_EQUAL(1, Sim::timerCalls());
+  CHECK_EQUAL(150, timerTimes[0]);
+}
+
+TEST(traceRecordsWritesAndPorts)
+{
+  pinMode(5, OUTPUT);
+  delay(1);
+  digitalWrite(5, HIGH);
+  delay(2);
+  digitalWrite(5, HIGH);
+  digitalWrite(5, LOW);
+  CHECK_EQUAL(3, Sim::pinWrites());
+  CHECK_EQUAL(2, Sim::transitions().size());
+  CHECK_EQUAL(2000, Sim::timeAtLevel(5, HIGH, 0, 5000));
+  CHECK_EQUAL(1000, Sim::timeAtLevel(5, HIGH, 2000, 5000));
+  CHECK_EQUAL(1, Sim::edgesToLevel(5, HIGH, 0, 5000));
+
+  // pin 9 = bit 1 of port 1, picked up by the next call into the core
+  *portOutputRegister(digitalPinToPort(9)) |= digitalPinToBitMask(9);
+  delay(1);
+  CHECK_EQUAL(HIGH, Sim::level(9));
+  CHECK_EQUAL(3, Sim::transitions().size());
+  CHECK_EQUAL(3000, Sim::transitions()[2].time);
+}
+
+TEST(writeTimeOpensGhostWindows)
+{
+  // digit D1 lit with the segments of the digit before: a ghost until the segments change
+  const byte expected[4] = { 0b00000110, 0, 0, 0 };
+  Sim::setWriteTime(4);
+  for (int i = 0; i < 8; i++)
+    digitalWrite(segmentPins[i], HIGH);
+  digitalWrite(digitPins[0], LOW);
+  Sim::clearTransitions();
+  unsigned long start = micros();
+
+  digitalWrite(segmentPins[0], LOW);
+  digitalWrite(digitPins[0], HIGH);
+  digitalWrite(segmentPins[0], HIGH);
+  digitalWrite(segmentPins[1], LOW);
+  digitalWrite(segmentPins[2], LOW);
+  delay(1);
+
+  GhostStats ghosts = findGhosts(expected, 4, true, start, micros());
+  CHECK_EQUAL(1, ghosts.windows);
+  CHECK_EQUAL(4, ghosts.time);
+  CHECK_EQUAL(0b00000110, litSegments(true));
+  CHECK_EQUAL(1, litDigits(true, 4));
+}
+
+TEST(allocationsAreCounted)
+{
+  // kept in a volatile pointer, so the compiler can't leave the allocation out
+  int* volatile number = new int(1);
+  delete number;
+  String text("a");
+  CHECK(Sim::allocations() >= 2);
+}
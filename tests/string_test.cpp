@@ -0,0 +1,63 @@
+/*
+  string_test.cpp - The String overloads read the text in place: no copy on the heap, same glyphs as the char* overloads.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+
+TEST(stringsAreNotCopied)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  String text("Hey!");
+  unsigned long allocations = Sim::allocations();
+
+  disp.setString(text);
+  disp.setScroller(text);
+  disp.appendScroller(text);
+  CHECK_EQUAL(0, Sim::allocations() - allocations);
+}
+
+TEST(stringsShowLikeCharPointers)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  SegmentController expected = SegmentController(true, segmentPins, digitPins, 4, 2);
+  String text("AbC1");
+  disp.setString(text, 1);
+  expected.setString("AbC1", 1);
+  for (int i = 0; i < 4; i++)
+    CHECK_EQUAL(expected.getDigit(i), disp.getDigit(i));
+
+  // an empty String leaves the display
+  disp.setString(String(""));
+  for (int i = 0; i < 4; i++)
+    CHECK_EQUAL(expected.getDigit(i), disp.getDigit(i));
+  CHECK_EQUAL(0, disp.appendScroller(String("")));
+}
+
+// a buffer on the stack of a function, gone once the function returns
+static void scrollFormatted(SegmentController& disp, int number)
+{
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "t=%d", number);
+  disp.setScroller(buffer);
+  memset(buffer, 0, sizeof(buffer));
+}
+
+TEST(charScrollerIsCopied)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  scrollFormatted(disp, 42);
+  CHECK_EQUAL(4, disp.getScrollerLength());
+  const char* expected = "t=42";
+  for (int i = 0; i < 4; i++)
+    CHECK_EQUAL(disp.getCharacter(expected[i]), disp.getScrollElement(i));
+
+  // setScrollerSource reads the text in place
+  char text[] = "abc";
+  disp.setScrollerSource(text);
+  text[1] = '7';
+  CHECK_EQUAL(3, disp.getScrollerLength());
+  CHECK_EQUAL(disp.getCharacter('7'), disp.getScrollElement(1));
+}
@@ -0,0 +1,516 @@
+/*
+  Arduino.cpp - Stand-in for the Arduino core to build and test the library on the host (see tests/CMakeLists.txt).
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "Arduino.h"
+#include <stdlib.h>
+#include <new>
+
+volatile uint8_t simPorts[SIM_PORTS];
+HardwareSerial Serial;
+
+namespace
+{
+  unsigned long now = 0;
+
+  // pin levels as last recorded (the port registers can be ahead of them), levels when the trace started
+  uint8_t known[SIM_PORTS];
+  uint8_t traceStart[SIM_PORTS];
+  std::vector<Sim::Transition> trace;
+  bool tracing = true;
+  unsigned long writes = 0;
+  unsigned long writeTime = 0;
+
+  unsigned long (*timerIsr)() = NULL;
+  unsigned long timerDue = 0;
+  unsigned long timerPeriod = 0;
+  unsigned long timerCount = 0;
+  bool insideIsr = false;
+  bool interruptsEnabled = true;
+  bool timerPending = false;
+  bool preemption = false;
+
+  unsigned long allocationCount = 0;
+
+  // record the pins changed through the port registers
+  void syncPorts()
+  {
+    for (int port = 0; port < SIM_PORTS; port++)
+    {
+      uint8_t changed = simPorts[port] ^ known[port];
+      for (int bit = 0; changed != 0 && tracing; bit++, changed >>= 1)
+        if (changed & 1)
+          trace.push_back(Sim::Transition{ now, (uint8_t)(port * 8 + bit), (uint8_t)((simPorts[port] >> bit) & 1) });
+      known[port] = simPorts[port];
+    }
+  }
+
+  void runTimer()
+  {
+    syncPorts();
+    insideIsr = true;
+    unsigned long next = timerIsr();
+    insideIsr = false;
+    syncPorts();
+    timerCount++;
+    timerDue += timerPeriod > 0 ? timerPeriod : (next > 0 ? next : 1);
+  }
+
+  // every call into the core from the main code
+  void enterCore()
+  {
+    syncPorts();
+    if (preemption && timerIsr != NULL && !insideIsr && interruptsEnabled)
+    {
+      unsigned long due = timerDue;
+      runTimer();
+      timerDue = due;
+    }
+  }
+}
+
+
+/*
+  --- PINS ---
+*/
+
+void pinMode(int pin, int mode)
+{
+  enterCore();
+}
+void digitalWrite(int pin, int value)
+{
+  enterCore();
+  // like the core: pins the board doesn't have are left alone
+  if (pin < 0 || pin >= NUM_DIGITAL_PINS)
+    return;
+  writes++;
+  uint8_t bit = digitalPinToBitMask(pin);
+  volatile uint8_t* port = portOutputRegister(digitalPinToPort(pin));
+  if (value != LOW)
+    *port |= bit;
+  else
+    *port &= ~bit;
+  syncPorts();
+  if (writeTime > 0)
+    Sim::advance(writeTime);
+}
+int digitalRead(int pin)
+{
+  enterCore();
+  if (pin < 0 || pin >= NUM_DIGITAL_PINS)
+    return LOW;
+  return Sim::level(pin);
+}
+void analogWrite(int pin, int value)
+{
+  // no pwm: only fully off or on
+  digitalWrite(pin, value >= 128 ? HIGH : LOW);
+}
+void shiftOut(int dataPin, int clockPin, int bitOrder, uint8_t value)
+{
+  for (int i = 0; i < 8; i++)
+  {
+    if (bitOrder == LSBFIRST)
+      digitalWrite(dataPin, (value >> i) & 1);
+    else
+      digitalWrite(dataPin, (value >> (7 - i)) & 1);
+    digitalWrite(clockPin, HIGH);
+    digitalWrite(clockPin, LOW);
+  }
+}
+
+
+/*
+  --- TIME ---
+*/
+
+unsigned long millis()
+{
+  enterCore();
+  return now / 1000;
+}
+unsigned long micros()
+{
+  enterCore();
+  return now;
+}
+void delay(unsigned long ms)
+{
+  enterCore();
+  Sim::advance(ms * 1000);
+}
+void delayMicroseconds(unsigned int us)
+{
+  enterCore();
+  Sim::advance(us);
+}
+
+void noInterrupts()
+{
+  interruptsEnabled = false;
+}
+void interrupts()
+{
+  interruptsEnabled = true;
+  // an interrupt that came while they were off runs now
+  if (timerPending && !insideIsr)
+  {
+    timerPending = false;
+    runTimer();
+  }
+  enterCore();
+}
+
+
+/*
+  --- SIMULATOR ---
+*/
+
+void Sim::reset()
+{
+  now = 0;
+  for (int port = 0; port < SIM_PORTS; port++)
+  {
+    simPorts[port] = 0;
+    known[port] = 0;
+  }
+  clearTransitions();
+  tracing = true;
+  writes = 0;
+  writeTime = 0;
+  timerIsr = NULL;
+  timerCount = 0;
+  interruptsEnabled = true;
+  timerPending = false;
+  preemption = false;
+  allocationCount = 0;
+}
+void Sim::advance(unsigned long us)
+{
+  syncPorts();
+  unsigned long target = now + us;
+  while (timerIsr != NULL && (long)(target - timerDue) >= 0)
+  {
+    now = timerDue;
+    if (interruptsEnabled && !insideIsr)
+      runTimer();
+    else
+    {
+      // runs as soon as the interrupts are enabled again
+      timerPending = true;
+      timerDue += timerPeriod > 0 ? timerPeriod : 1;
+    }
+  }
+  now = target;
+}
+
+void Sim::attachTimer(unsigned long (*isr)(), unsigned long firstDelay, unsigned long period)
+{
+  timerIsr = isr;
+  timerDue = now + firstDelay;
+  timerPeriod = period;
+}
+void Sim::detachTimer()
+{
+  timerIsr = NULL;
+}
+void Sim::setPreemption(bool value)
+{
+  preemption = value;
+}
+unsigned long Sim::timerCalls()
+{
+  return timerCount;
+}
+
+uint8_t Sim::level(int pin)
+{
+  return (simPorts[pin / 8] >> (pin % 8)) & 1;
+}
+const std::vector<Sim::Transition>& Sim::transitions()
+{
+  syncPorts();
+  return trace;
+}
+void Sim::clearTransitions()
+{
+  syncPorts();
+  trace.clear();
+  for (int port = 0; port < SIM_PORTS; port++)
+    traceStart[port] = known[port];
+}
+void Sim::setTrace(bool value)
+{
+  syncPorts();
+  tracing = value;
+}
+void Sim::setWriteTime(unsigned long us)
+{
+  writeTime = us;
+}
+uint8_t Sim::startLevel(int pin)
+{
+  return (traceStart[pin / 8] >> (pin % 8)) & 1;
+}
+unsigned long Sim::pinWrites()
+{
+  return writes;
+}
+
+unsigned long Sim::timeAtLevel(int pin, uint8_t level, unsigned long from, unsigned long to)
+{
+  // replay the trace of the pin from its level at the start
+  const std::vector<Transition>& changes = transitions();
+  uint8_t current = startLevel(pin);
+  unsigned long since = from;
+  unsigned long time = 0;
+  for (size_t i = 0; i < changes.size() && changes[i].time < to; i++)
+  {
+    if (changes[i].pin != pin || changes[i].level == current)
+      continue;
+    if (changes[i].time > from && current == level)
+      time += changes[i].time - since;
+    if (changes[i].time > since)
+      since = changes[i].time;
+    current = changes[i].level;
+  }
+  if (current == level && to > since)
+    time += to - since;
+  return time;
+}
+unsigned long Sim::edgesToLevel(int pin, uint8_t level, unsigned long from, unsigned long to)
+{
+  const std::vector<Transition>& changes = transitions();
+  uint8_t current = startLevel(pin);
+  unsigned long edges = 0;
+  for (size_t i = 0; i < changes.size() && changes[i].time < to; i++)
+  {
+    if (changes[i].pin != pin || changes[i].level == current)
+      continue;
+    current = changes[i].level;
+    if (current == level && changes[i].time >= from)
+      edges++;
+  }
+  return edges;
+}
+
+unsigned long Sim::allocations()
+{
+  return allocationCount;
+}
+
+
+/*
+  --- PRINT ---
+*/
+
+size_t Print::write(const uint8_t* buffer, size_t size)
+{
+  size_t n = 0;
+  while (size--)
+  {
+    if (write(*buffer++))
+      n++;
+    else
+      break;
+  }
+  return n;
+}
+
+size_t Print::print(const __FlashStringHelper* text)
+{
+  return write(reinterpret_cast<const char*>(text));
+}
+size_t Print::print(const char text[])
+{
+  return write(text);
+}
+size_t Print::print(char character)
+{
+  return write((uint8_t)character);
+}
+size_t Print::print(unsigned char number, int base)
+{
+  return print((unsigned long)number, base);
+}
+size_t Print::print(int number, int base)
+{
+  return print((long)number, base);
+}
+size_t Print::print(unsigned int number, int base)
+{
+  return print((unsigned long)number, base);
+}
+size_t Print::print(long number, int base)
+{
+  if (base == 0)
+    return write((uint8_t)number);
+  if (base == DEC && number < 0)
+  {
+    size_t n = print('-');
+    return n + printNumber(0UL - (unsigned long)number, DEC);
+  }
+  return printNumber(number, base);
+}
+size_t Print::print(unsigned long number, int base)
+{
+  if (base == 0)
+    return write((uint8_t)number);
+  return printNumber(number, base);
+}
+size_t Print::print(double number, int digits)
+{
+  return printFloat(number, digits);
+}
+size_t Print::println()
+{
+  return write("\r\n");
+}
+
+size_t Print::printNumber(unsigned long number, uint8_t base)
+{
+  // filled from the end, like the core
+  char buffer[8 * sizeof(long) + 1];
+  char* text = &buffer[sizeof(buffer) - 1];
+  *text = '\0';
+  if (base < 2)
+    base = 10;
+  do
+  {
+    char digit = number % base;
+    number /= base;
+    *--text = digit < 10 ? digit + '0' : digit + 'A' - 10;
+  }
+  while (number > 0);
+  return write(text);
+}
+size_t Print::printFloat(double number, uint8_t digits)
+{
+  if (isnan(number))
+    return print("nan");
+  if (isinf(number))
+    return print("inf");
+
+  size_t n = 0;
+  if (number < 0.0)
+  {
+    n += print('-');
+    number = -number;
+  }
+
+  // round to the printed digits
+  double rounding = 0.5;
+  for (uint8_t i = 0; i < digits; i++)
+    rounding /= 10.0;
+  number += rounding;
+
+  unsigned long integer = (unsigned long)number;
+  double remainder = number - (double)integer;
+  n += print(integer);
+  if (digits > 0)
+    n += print('.');
+  while (digits-- > 0)
+  {
+    remainder *= 10.0;
+    unsigned int digit = (unsigned int)remainder;
+    n += print(digit);
+    remainder -= digit;
+  }
+  return n;
+}
+
+
+/*
+  --- STRING ---
+*/
+
+String::String(const char* text)
+{
+  copy(text);
+}
+String::String(const String& other)
+{
+  copy(other._buffer);
+}
+String& String::operator=(const String& other)
+{
+  if (this != &other)
+    copy(other._buffer);
+  return *this;
+}
+String::~String()
+{
+  free(_buffer);
+}
+void String::copy(const char* text)
+{
+  _length = text != NULL ? strlen(text) : 0;
+  _buffer = (char*)realloc(_buffer, _length + 1);
+  memcpy(_buffer, text != NULL ? text : "", _length);
+  _buffer[_length] = '\0';
+}
+
+
+/*
+  --- ALLOCATIONS ---
+*/
+
+// with SIM_WRAP_MALLOC the library is linked with -Wl,--wrap=malloc,--wrap=realloc,--wrap=calloc and every call is counted there
+#ifdef SIM_WRAP_MALLOC
+extern "C"
+{
+  void* __real_malloc(size_t size);
+  void* __real_realloc(void* pointer, size_t size);
+  void* __real_calloc(size_t count, size_t size);
+
+  void* __wrap_malloc(size_t size)
+  {
+    allocationCount++;
+    return __real_malloc(size);
+  }
+  void* __wrap_realloc(void* pointer, size_t size)
+  {
+    allocationCount++;
+    return __real_realloc(pointer, size);
+  }
+  void* __wrap_calloc(size_t count, size_t size)
+  {
+    allocationCount++;
+    return __real_calloc(count, size);
+  }
+}
+#endif
+
+void* operator new(size_t size)
+{
+#ifndef SIM_WRAP_MALLOC
+  allocationCount++;
+#endif
+  void* pointer = malloc(size > 0 ? size : 1);
+  if (pointer == NULL)
+    throw std::bad_alloc();
+  return pointer;
+}
+void* operator new[](size_t size)
+{
+  return operator new(size);
+}
+void operator delete(void* pointer) noexcept
+{
+  free(pointer);
+}
+void operator delete[](void* pointer) noexcept
+{
+  free(pointer);
+}
+void operator delete(void* pointer, size_t size) noexcept
+{
+  free(pointer);
+}
+void operator delete[](void* pointer, size_t size) noexcept
+{
+  free(pointer);
+}
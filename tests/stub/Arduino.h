@@ -0,0 +1,198 @@
+/*
+  Arduino.h - Stand-in for the Arduino core to build and test the library on the host (see tests/CMakeLists.txt).
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+/*
+--- simulator ---
+
+  the time only moves with delay(), delayMicroseconds() and Sim::advance(), a timer interrupt (Sim::attachTimer) runs on this clock
+  every pin write is recorded with its time, pins written through the mock port registers (SEGMENT_FAST_IO) are picked up on the next call
+*/
+
+
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <math.h>
+#include <ctype.h>
+#include <string>
+#include <vector>
+
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+// pins of the simulated board (8 per port)
+#define NUM_DIGITAL_PINS 64
+#define SIM_PORTS (NUM_DIGITAL_PINS / 8)
+
+
+// flash is ordinary memory on the host
+#define PROGMEM
+#define PGM_P const char*
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_word(p) (*(const uint16_t*)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+#define pgm_read_ptr(p) (*(void* const*)(p))
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+
+// port registers for SEGMENT_FAST_IO, digitalWrite writes them too
+extern volatile uint8_t simPorts[SIM_PORTS];
+#define digitalPinToPort(p) ((p) / 8)
+#define portOutputRegister(port) (&simPorts[port])
+#define digitalPinToBitMask(p) (1 << ((p) % 8))
+
+
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+int digitalRead(int pin);
+void analogWrite(int pin, int value);
+void shiftOut(int dataPin, int clockPin, int bitOrder, uint8_t value);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void noInterrupts();
+void interrupts();
+
+inline bool isAlpha(int c) { return isalpha(c) != 0; }
+inline bool isDigit(int c) { return isdigit(c) != 0; }
+
+
+namespace Sim
+{
+  // a level change of a pin, at a time (in microseconds)
+  struct Transition
+  {
+    unsigned long time;
+    uint8_t pin;
+    uint8_t level;
+  };
+
+  // clock to 0, every pin low, no timer, empty trace and counters, writes take no time
+  void reset();
+  // move the clock, the timer interrupt runs at its times on the way
+  void advance(unsigned long us);
+
+  // call isr after firstDelay microseconds and then again after the time it returns (like scan()), period > 0 ignores the returned time
+  void attachTimer(unsigned long (*isr)(), unsigned long firstDelay, unsigned long period = 0);
+  void detachTimer();
+  // let the timer interrupt also run inside every call into the core from the main code (e.g. in the middle of setInt), no matter its time
+  void setPreemption(bool value);
+  // calls of the timer interrupt
+  unsigned long timerCalls();
+
+  // current level of a pin
+  uint8_t level(int pin);
+  // the recorded level changes (the pins written through the port registers included)
+  const std::vector<Transition>& transitions();
+  void clearTransitions();
+  // record the level changes (default), off for measuring the CPU time of the library
+  void setTrace(bool value);
+  // level of a pin when the trace started (reset/clearTransitions)
+  uint8_t startLevel(int pin);
+  // calls of digitalWrite/analogWrite (also by shiftOut)
+  unsigned long pinWrites();
+  // time (in microseconds) a digitalWrite takes, e.g. about 4 on a 16 MHz AVR (default 0: the writes take no time, port registers never do)
+  void setWriteTime(unsigned long us);
+
+  // time (in microseconds) a pin spent on a level between from and to, and how often it went to the level
+  unsigned long timeAtLevel(int pin, uint8_t level, unsigned long from, unsigned long to);
+  unsigned long edgesToLevel(int pin, uint8_t level, unsigned long from, unsigned long to);
+
+  // allocations (operator new, malloc, realloc) since the last reset
+  unsigned long allocations();
+}
+
+
+// Print of the Arduino core: the formatting is done into buffers on the stack
+class Print
+{
+  public:
+    virtual ~Print() { }
+
+    virtual size_t write(uint8_t character) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* text) { return text == NULL ? 0 : write((const uint8_t*)text, strlen(text)); }
+    size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+    virtual void flush() { }
+
+    size_t print(const __FlashStringHelper* text);
+    size_t print(const char text[]);
+    size_t print(char character);
+    size_t print(unsigned char number, int base = DEC);
+    size_t print(int number, int base = DEC);
+    size_t print(unsigned int number, int base = DEC);
+    size_t print(long number, int base = DEC);
+    size_t print(unsigned long number, int base = DEC);
+    size_t print(double number, int digits = 2);
+
+    size_t println();
+    template <typename T> size_t println(T value) { size_t n = print(value); return n + println(); }
+    template <typename T> size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+
+  private:
+    size_t printNumber(unsigned long number, uint8_t base);
+    size_t printFloat(double number, uint8_t digits);
+};
+
+// the parts of String the library uses, on the heap like the original (no small string buffer)
+class String
+{
+  public:
+    String(const char* text = "");
+    String(const String& other);
+    String& operator=(const String& other);
+    ~String();
+
+    unsigned int length() const { return _length; }
+    const char* c_str() const { return _buffer; }
+    char operator[](unsigned int index) const { return index < _length ? _buffer[index] : '\0'; }
+
+  private:
+    void copy(const char* text);
+
+    char* _buffer = NULL;
+    unsigned int _length = 0;
+};
+
+// writes to stdout
+class HardwareSerial : public Print
+{
+  public:
+    void begin(unsigned long baud) { }
+    size_t write(uint8_t character) { return fputc(character, stdout) == EOF ? 0 : 1; }
+    using Print::write;
+};
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,188 @@
+/*
+  timeline_test.cpp - Timelines in flash: frames start on time even after a late refresh(), zero-length frames, loops and the frame effects ending with the timeline.
+  Created by Donut Studio, October 17, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+
+static SegmentController* timerDisplay = NULL;
+
+static unsigned long timerScan()
+{
+  return timerDisplay->scan();
+}
+
+// the frame index on the left-most digit, a zero-length frame in the middle
+const SegmentFrame frames[] PROGMEM =
+{
+  { { 1, 0, 0, 0 }, 100, 0 },
+  { { 2, 0, 0, 0 }, 50, 0 },
+  { { 3, 0, 0, 0 }, 0, 0 },
+  { { 4, 0, 0, 0 }, 200, 0 }
+};
+
+// refresh() at a time (in milliseconds since the timeline started), the interrupt mode doesn't wait in refresh()
+static void refreshAt(SegmentController& disp, unsigned long time)
+{
+  Sim::advance(time * 1000 - micros());
+  disp.refresh();
+}
+
+static SegmentController createDisplay()
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  return disp;
+}
+
+TEST(framesStartOnTime)
+{
+  SegmentController disp = createDisplay();
+  disp.playTimeline(frames, 4);
+  CHECK(disp.isTimelinePlaying());
+  CHECK_EQUAL(1, disp.getDigit(0));
+
+  refreshAt(disp, 99);
+  CHECK_EQUAL(0, disp.getTimelineFrame());
+  refreshAt(disp, 100);
+  CHECK_EQUAL(1, disp.getTimelineFrame());
+  CHECK_EQUAL(2, disp.getDigit(0));
+  // the zero-length frame is never shown
+  refreshAt(disp, 150);
+  CHECK_EQUAL(3, disp.getTimelineFrame());
+  CHECK_EQUAL(4, disp.getDigit(0));
+
+  // the last frame stays once it is over
+  refreshAt(disp, 349);
+  CHECK(disp.isTimelinePlaying());
+  refreshAt(disp, 350);
+  CHECK(!disp.isTimelinePlaying());
+  CHECK_EQUAL(3, disp.getTimelineFrame());
+  CHECK_EQUAL(4, disp.getDigit(0));
+}
+
+TEST(lateRefreshSkipsFrames)
+{
+  SegmentController disp = createDisplay();
+  disp.playTimeline(frames, 4);
+
+  // frames 1 and 2 are over already, the last one still ends 350 ms after the start (no drift)
+  refreshAt(disp, 160);
+  CHECK_EQUAL(3, disp.getTimelineFrame());
+  CHECK_EQUAL(4, disp.getDigit(0));
+  refreshAt(disp, 349);
+  CHECK(disp.isTimelinePlaying());
+  refreshAt(disp, 350);
+  CHECK(!disp.isTimelinePlaying());
+
+  // the whole timeline missed: the last frame stays
+  disp.playTimeline(frames, 4);
+  refreshAt(disp, 2000);
+  CHECK(!disp.isTimelinePlaying());
+  CHECK_EQUAL(4, disp.getDigit(0));
+}
+
+TEST(loopsStartOver)
+{
+  SegmentController disp = createDisplay();
+  disp.playTimeline(frames, 4, true);
+  refreshAt(disp, 349);
+  CHECK_EQUAL(3, disp.getTimelineFrame());
+  refreshAt(disp, 350);
+  CHECK(disp.isTimelinePlaying());
+  CHECK_EQUAL(0, disp.getTimelineFrame());
+  CHECK_EQUAL(1, disp.getDigit(0));
+  refreshAt(disp, 450);
+  CHECK_EQUAL(1, disp.getTimelineFrame());
+
+  // whole loops missed: the loops still start every 350 ms (at 1400 and 1750)
+  refreshAt(disp, 1500);
+  CHECK_EQUAL(1, disp.getTimelineFrame());
+  CHECK_EQUAL(2, disp.getDigit(0));
+  refreshAt(disp, 1549);
+  CHECK_EQUAL(1, disp.getTimelineFrame());
+  refreshAt(disp, 1550);
+  CHECK_EQUAL(3, disp.getTimelineFrame());
+  refreshAt(disp, 1749);
+  CHECK_EQUAL(3, disp.getTimelineFrame());
+  refreshAt(disp, 1750);
+  CHECK_EQUAL(0, disp.getTimelineFrame());
+  refreshAt(disp, 11190);
+  CHECK_EQUAL(3, disp.getTimelineFrame());
+}
+
+const SegmentFrame emptyFrames[] PROGMEM =
+{
+  { { 1, 0, 0, 0 }, 0, 0 },
+  { { 2, 0, 0, 0 }, 0, 0 }
+};
+
+TEST(loopOfZeroLengthFrames)
+{
+  SegmentController disp = createDisplay();
+  disp.playTimeline(emptyFrames, 2, true);
+
+  // over in no time: every refresh() moves on, none of them gets stuck
+  for (unsigned long t = 1; t < 10; t++)
+  {
+    refreshAt(disp, t);
+    CHECK(disp.isTimelinePlaying());
+  }
+  disp.stopTimeline();
+  CHECK(!disp.isTimelinePlaying());
+}
+
+const SegmentFrame alarm[] PROGMEM =
+{
+  { { 0x7F, 0x7F, 0x7F, 0x7F }, 1000, FRAME_BLINK },
+  { { 0x7F, 0x7F, 0x7F, 0x7F }, 1000, FRAME_DIM },
+  { { 0x7F, 0x7F, 0x7F, 0x7F }, 1000, FRAME_BLINK | FRAME_DIM }
+};
+
+// the on-time of the left-most digit in the next second of the timer driven scan, the timeline moves on at its end
+static unsigned long nextSecond(SegmentController& disp)
+{
+  unsigned long start = micros();
+  for (int i = 0; i < 100; i++)
+  {
+    disp.refresh();
+    delay(10);
+  }
+  unsigned long end = micros();
+  disp.refresh();
+  return digitOnTime(0, true, start, end);
+}
+
+TEST(frameEffectsEndWithTheTimeline)
+{
+  SegmentController disp = createDisplay();
+  timerDisplay = &disp;
+  Sim::attachTimer(timerScan, 100);
+
+  // a full digit is lit a fifth of the time
+  disp.playTimeline(alarm, 3);
+  CHECK(disp.getBlinking(0));
+  CHECK_NEAR(100000, nextSecond(disp), 11000);
+  CHECK(!disp.getBlinking(0));
+  unsigned long dimmed = nextSecond(disp);
+  CHECK(dimmed < 200000 / 4);
+  CHECK(disp.getBlinking(0));
+
+  // stopped in a blinking, dimmed frame: both effects go, the frame stays
+  disp.stopTimeline();
+  CHECK(!disp.getBlinking(0));
+  CHECK_NEAR(200000, nextSecond(disp), 2000);
+  CHECK_EQUAL(0x7F, disp.getDigit(0));
+
+  // also when a set function stops it
+  disp.playTimeline(alarm, 3);
+  delay(2500);
+  disp.refresh();
+  CHECK_EQUAL(2, disp.getTimelineFrame());
+  disp.setInt(1234);
+  CHECK(!disp.isTimelinePlaying());
+  CHECK(!disp.getBlinking(0));
+  CHECK_NEAR(200000, nextSecond(disp), 2000);
+}
@@ -0,0 +1,121 @@
+/*
+  translate_test.cpp - Bytes translated once per frame: every byte lights exactly its segments, with either polarity and without a dp.
+  Created by Donut Studio, October 16, 2026.
+  Released into the public domain.
+*/
+
+#include "DonutStudioSevenSegment.h"
+#include "SegmentTest.h"
+
+// the first scan of a frame lights the right-most digit (D4) with the byte of the new frame
+static void checkAllBytes(SegmentControllerBase& disp, bool commonAnode, byte segmentMask)
+{
+  for (int b = 0; b < 256; b++)
+  {
+    byte bytes[4] = { (byte)b, (byte)b, (byte)b, (byte)b };
+    disp.setByte(bytes);
+    disp.refresh();
+    disp.setRefreshMode(REFRESH_INTERRUPT);
+    disp.scan();
+    CHECK_EQUAL(8, litDigits(commonAnode, 4));
+    CHECK_EQUAL(b & segmentMask, litSegments(commonAnode) & segmentMask);
+  }
+}
+
+TEST(commonAnodeBytes)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  checkAllBytes(disp, true, 0xFF);
+}
+
+TEST(commonCathodeBytes)
+{
+  SegmentController disp = SegmentController(false, segmentPins, digitPins, 4, 2);
+  checkAllBytes(disp, false, 0xFF);
+}
+
+TEST(staticControllerBytes)
+{
+  StaticSegmentController<4, true> anode(segmentPins, digitPins, 2);
+  checkAllBytes(anode, true, 0xFF);
+
+  Sim::reset();
+  StaticSegmentController<4, false> cathode(segmentPins, digitPins, 2);
+  checkAllBytes(cathode, false, 0xFF);
+}
+
+TEST(withoutDp)
+{
+  int pins[8] = { segmentPins[0], segmentPins[1], segmentPins[2], segmentPins[3], segmentPins[4], segmentPins[5], segmentPins[6], -1 };
+  SegmentController disp = SegmentController(true, pins, digitPins, 4, 2);
+  checkAllBytes(disp, true, 0x7F);
+
+  // the segment scan has 7 segment lines: 2 frames in 14 scans
+  disp.setScanMode(SCAN_SEGMENTS);
+  disp.resetStats();
+  for (int i = 0; i < 14; i++)
+    disp.scan();
+  CHECK_EQUAL(2, disp.getStats().frames);
+
+  Sim::reset();
+  StaticSegmentController<4, false, false> cathode(pins, digitPins, 2);
+  checkAllBytes(cathode, false, 0x7F);
+}
+
+TEST(sameSegmentsAreNotWrittenAgain)
+{
+  SegmentController disp = SegmentController(true, segmentPins, digitPins, 4, 2);
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  disp.setInt(8888);
+  disp.refresh();
+  for (int i = 0; i < 5; i++)
+    disp.scan();
+
+  // the same glyph on every digit: only the digit pins change (the one going off and the next one)
+  Sim::clearTransitions();
+  for (int i = 0; i < 10; i++)
+    disp.scan();
+  for (size_t i = 0; i < Sim::transitions().size(); i++)
+    for (int s = 0; s < 8; s++)
+      CHECK(Sim::transitions()[i].pin != segmentPins[s]);
+}
+
+// the scan of a display, as the level changes it makes (the times left out)
+static std::vector<unsigned int> scanTrace(SegmentControllerBase& disp, byte scanMode)
+{
+  disp.setRefreshMode(REFRESH_INTERRUPT);
+  disp.setScanMode(scanMode);
+  disp.setInt(-127);
+  disp.setDigitSegment(1, 7, true);
+  disp.refresh();
+  Sim::clearTransitions();
+  for (int i = 0; i < 24; i++)
+    disp.scan();
+
+  std::vector<unsigned int> trace;
+  for (size_t i = 0; i < Sim::transitions().size(); i++)
+    trace.push_back(Sim::transitions()[i].pin << 8 | Sim::transitions()[i].level);
+  return trace;
+}
+
+TEST(staticDriverWritesLikeTheRuntimeOne)
+{
+  int pins[8] = { segmentPins[0], segmentPins[1], segmentPins[2], segmentPins[3], segmentPins[4], segmentPins[5], segmentPins[6], -1 };
+  for (int scanMode = SCAN_DIGITS; scanMode <= SCAN_SEGMENTS; scanMode++)
+  {
+    Sim::reset();
+    SegmentController anode = SegmentController(true, segmentPins, digitPins, 4, 2);
+    std::vector<unsigned int> expected = scanTrace(anode, scanMode);
+    Sim::reset();
+    StaticSegmentController<4, true> staticAnode(segmentPins, digitPins, 2);
+    CHECK(expected == scanTrace(staticAnode, scanMode));
+
+    Sim::reset();
+    SegmentController cathode = SegmentController(false, pins, digitPins, 4, 2);
+    expected = scanTrace(cathode, scanMode);
+    Sim::reset();
+    StaticSegmentController<4, false, false> staticCathode(pins, digitPins, 2);
+    CHECK(expected == scanTrace(staticCathode, scanMode));
+    CHECK(expected.size() > 0);
+  }
+}